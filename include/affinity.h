@@ -0,0 +1,39 @@
+#ifndef AFFINITY_H
+#define AFFINITY_H
+
+#include <vector>
+
+// Thread placement policy for the parallel optimizer
+enum AffinityPolicy {
+    AFFINITY_NONE,      // leave placement to the OS
+    AFFINITY_COMPACT,   // fill one socket before moving to the next
+    AFFINITY_SCATTER    // round-robin over sockets
+};
+
+// Pins the calling OpenMP thread: thread t of the team goes to the t-th
+// CPU in policy order (wrapping around if there are more threads than CPUs).
+// Call from inside a parallel region. No-op for AFFINITY_NONE and on
+// systems without sched_setaffinity (e.g. macOS).
+void pinCurrentThread(AffinityPolicy policy);
+
+// CPUs a thread may run on, saved before pinning so the thread's
+// original placement can be restored afterwards
+struct SavedAffinity {
+    std::vector<int> cpus;   // empty = nothing to restore
+};
+
+// Mask of the calling thread (empty without sched_getaffinity)
+SavedAffinity saveAffinity();
+
+// Sets the calling thread's mask back to `saved`. No-op if empty.
+void restoreAffinity(const SavedAffinity& saved);
+
+// Number of sockets (physical packages) among the CPUs the process may use
+int socketCount();
+
+// "none" / "compact" / "scatter" -> policy. Returns false if unknown.
+bool parseAffinity(const char* text, AffinityPolicy& policy);
+
+const char* affinityName(AffinityPolicy policy);
+
+#endif // AFFINITY_H
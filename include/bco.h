@@ -2,17 +2,33 @@
 #define BCO_H
 
 #include "pid_simulator.h"
+#include "affinity.h"
+#include "scenario.h"
 
-// One bee = one PID candidate
-struct Bee {
-    PIDParams pid;   // Kp, Ki, Kd
-    double fitness;  // MSE
-    int trials;      // how many times it failed to improve
+// What a bee's fitness measures
+enum FitnessMode {
+    FITNESS_NOMINAL,    // MSE of the unit step on the nominal plant (simulatePID)
+    FITNESS_SCENARIOS   // aggregate MSE over BCOSettings::scenarios (simulatePIDBatch)
 };
 
+// Optional per-iteration callback: iteration, best MSE so far, running
+// number of simulatePID calls, and the user pointer from BCOSettings.
+typedef void (*BCOProgressFn)(int iteration, double bestMSE,
+                              long long evaluations, void* user);
+
+struct BeePopulation;   // bee_population.h
+
+// Optional hook on the greedy decisions of the employed and onlooker
+// phases: called once the candidates of bees [begin, end) are evaluated
+// and before selection, so pop holds each active bee's current and
+// candidate gains and fitness. Called by the worker running the chunk
+// (concurrently with other chunks on parallel backends).
+typedef void (*BCOSelectionFn)(int iteration, const BeePopulation& pop,
+                               int begin, int end, void* user);
+
 // Settings for the BCO algorithm
 struct BCOSettings {
-    int numBees;        // size of the bee population
+    int numBees;        // size of the bee population (>= 2)
     int maxIterations;  // how many iterations to run
     int limit;          // scout limit (stagnation threshold)
 
@@ -22,8 +38,60 @@ struct BCOSettings {
 
     double dt;          // simulation time step
     double simTime;     // total simulation time
+
+    int seed = 12345;   // RNG base seed (population chunk c uses seed + c)
+
+    Precision precision = PRECISION_DOUBLE;  // simulation kernel precision
+
+    AffinityPolicy affinity = AFFINITY_NONE; // thread pinning (parallel version)
+
+    // Robust tuning: fitness over a scenario batch instead of the nominal plant
+    FitnessMode fitnessMode = FITNESS_NOMINAL;
+    const ScenarioBatch* scenarios = nullptr;       // required for FITNESS_SCENARIOS
+    ScenarioAggregate aggregate = AGGREGATE_MEAN;   // mean or worst-case MSE
+
+    // Hybrid local refinement (Nelder-Mead on the best bees)
+    int refineEvery = 0;        // refine every N iterations (0 = off)
+    int refineTopK = 1;         // how many of the best bees to refine
+    int refineMaxEvals = 60;    // simulatePID budget per refined bee
+    double refineStep = 0.05;   // initial simplex size, fraction of each gain range
+
+    // Adaptive population: every adaptEvery iterations the colony grows
+    // (adding random bees) while it is spread out and improving, and
+    // shrinks (dropping its worst bees) once it has converged, i.e. its
+    // diversity (populationDiversity) is below diversityLow, or stalled,
+    // i.e. the best MSE improved by less than stallRate (relative) since
+    // the last check. numBees is the starting size; the colony stays
+    // within [minBees, maxBees].
+    bool adaptivePopulation = false;
+    int minBees = 20;
+    int maxBees = 200;
+    int adaptEvery = 10;
+    double adaptStep = 0.25;        // resize by this fraction of the current size
+    double diversityLow = 0.02;
+    double stallRate = 0.01;
+
+    // If set, the best controller is simulated once more into this trace
+    // after the run (nominal plant, double precision; see trace.h)
+    TraceBuffer* bestTrace = nullptr;
+
+    BCOProgressFn progress = nullptr;   // called after every iteration (optional)
+    void* progressUser = nullptr;       // passed through to progress
+
+    BCOSelectionFn selection = nullptr; // greedy-decision hook (optional)
+    void* selectionUser = nullptr;      // passed through to selection
 };
 
+// Fitness of one candidate under settings.fitnessMode, simulated with
+// settings.precision. cutoff = fitness the candidate has to beat; scenario
+// batches stop early (returning a value >= cutoff) once they cannot beat it.
+// Throws std::invalid_argument for FITNESS_SCENARIOS without scenarios.
+double evaluateFitness(const PIDParams& params,
+                       const double* num, int numSize,
+                       const double* den, int denSize,
+                       const BCOSettings& settings,
+                       double cutoff);
+
 // Runs BCO for a single plant (given by num/den).
 // bestParams and bestMSE will be filled with the best found solution.
 // logFilePath: CSV file path for logging
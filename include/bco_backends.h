@@ -0,0 +1,32 @@
+#ifndef BCO_BACKENDS_H
+#define BCO_BACKENDS_H
+
+#include "bco.h"
+
+// Execution backends of the BCO core (bco_core.h)
+enum ExecutionBackend {
+    BACKEND_SEQUENTIAL,     // one chunk on the calling thread (= runBCO)
+    BACKEND_OPENMP,         // one chunk per OpenMP thread (= runBCOParallel)
+    BACKEND_STDPAR,         // std::for_each(std::execution::par_unseq) over chunks
+    BACKEND_WORKSTEALING    // custom work-stealing pool (thread_pool.h)
+};
+
+// "seq" / "omp" / "stdpar" / "ws" -> backend. Returns false if unknown.
+bool parseBackend(const char* text, ExecutionBackend& backend);
+
+const char* backendName(ExecutionBackend backend);
+
+// Runs BCO on the chosen backend with `threads` workers (ignored by the
+// sequential backend; for std::execution it sets the chunk count, the
+// library picks the threads). Same results for the same seed and chunk
+// count, e.g. seq and omp with one thread; refinement follows the same
+// schedule on every backend.
+void runBCOWithBackend(ExecutionBackend backend, int threads,
+                       const double* num, int numSize,
+                       const double* den, int denSize,
+                       const BCOSettings& settings,
+                       PIDParams& bestParams,
+                       double& bestMSE,
+                       const char* logFilePath);
+
+#endif // BCO_BACKENDS_H
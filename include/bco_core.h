@@ -0,0 +1,301 @@
+#ifndef BCO_CORE_H
+#define BCO_CORE_H
+
+#include "bco.h"
+#include "bee_population.h"
+#include "local_search.h"
+#include "executors.h"
+#include <vector>
+#include <random>
+#include <fstream>
+#include <future>   // asynchronous refinement
+#include <algorithm>
+#include <stdexcept>
+
+// Evaluates the active candidates of bees [begin, end).
+// greedy = candidate only matters if it beats the bee (allows early exit)
+// Returns the number of simulations run. (bco.cpp)
+int evaluateRange(BeePopulation& pop, int begin, int end,
+                  const double* num, int numSize,
+                  const double* den, int denSize,
+                  const BCOSettings& settings,
+                  bool greedy);
+
+// One CSV line: iteration,bestMSE,Kp,Ki,Kd,evaluations,numBees (bco.cpp)
+void logToCSV(std::ofstream& out, int iteration,
+              const PIDParams& best, double bestMSE,
+              long long evaluations, int numBees);
+
+
+// lowest fitness over the best indices of the first `chunks` chunks
+// (first chunk on ties, i.e. lowest index, whatever the order the chunks
+// finished in)
+inline int reduceBest(const BeePopulation& pop, const std::vector<int>& chunkBest, int chunks)
+{
+    int best = chunkBest[0];
+    for (int c = 0; c < chunks; c++) {
+        int index = chunkBest.at(c);
+        if (pop.fitness[index] < pop.fitness[best]) best = index;
+    }
+    return best;
+}
+
+inline void updateBest(const BeePopulation& pop, int index,
+                       PIDParams& bestParams, double& bestMSE)
+{
+    if (pop.fitness[index] < bestMSE) {
+        bestMSE = pop.fitness[index];
+        bestParams.Kp = pop.Kp[index];
+        bestParams.Ki = pop.Ki[index];
+        bestParams.Kd = pop.Kd[index];
+    }
+}
+
+
+// Unpins the executor's threads when the run ends, also on an exception
+// (declared before the refinement future, so that is joined first)
+template <class Executor>
+struct UnpinGuard {
+    Executor& exec;
+    explicit UnpinGuard(Executor& e) : exec(e) {}
+    ~UnpinGuard() { exec.unpinThreads(); }
+};
+
+
+// BCO core shared by every backend (runBCO, runBCOParallel,
+// runBCOWithBackend). The colony is split into up to exec.chunks() static
+// chunks; chunk c has its own RNG seeded settings.seed + c, so the result
+// depends on the seed and the chunk count only, not on which thread runs
+// which chunk. Each phase is one exec.run(): the fork-join boundaries
+// separate reads of partner gains from the greedy writes. Evaluation
+// counts and best indices are kept per chunk and reduced afterwards.
+// With settings.adaptivePopulation the colony is resized between
+// iterations inside a pool of maxBees bees, and the chunks are recomputed
+// from the new size.
+template <class Executor>
+void runBCOCore(Executor& exec,
+                const double* num, int numSize,
+                const double* den, int denSize,
+                const BCOSettings& settings,
+                PIDParams& bestParams,
+                double& bestMSE,
+                const char* logFilePath)
+{
+    // checked before any worker runs: evaluateFitness would throw inside
+    // a parallel region, which terminates the program
+    if (settings.fitnessMode == FITNESS_SCENARIOS && settings.scenarios == nullptr) {
+        throw std::invalid_argument("FITNESS_SCENARIOS needs BCOSettings::scenarios");
+    }
+    // every bee draws a partner k != i
+    if (settings.numBees < 2) {
+        throw std::invalid_argument("BCOSettings::numBees must be >= 2");
+    }
+
+    // colony size bounds (partner draws need at least 2 bees)
+    int minBees = settings.numBees;
+    int maxBees = settings.numBees;
+    if (settings.adaptivePopulation) {
+        minBees = std::max(2, std::min(settings.minBees, settings.numBees));
+        maxBees = std::max(settings.maxBees, settings.numBees);
+    }
+
+    BeePopulation pop;
+    allocatePopulation(pop, maxBees);
+
+    // per-chunk state, sized for the largest colony
+    const int maxChunks = std::min(exec.chunks(), maxBees);
+
+    std::vector<std::mt19937> rngs(maxChunks);
+    for (int c = 0; c < maxChunks; c++) rngs[c].seed(settings.seed + c);
+
+    std::vector<long long> chunkEvals(maxChunks, 0);
+    std::vector<int> chunkBest(maxChunks, 0);
+
+    std::ofstream logFile;
+    if (logFilePath != nullptr) {
+        logFile.open(logFilePath);
+        if (logFile.is_open()) {
+            logFile << "iteration,bestMSE,Kp,Ki,Kd,evaluations,numBees\n";
+        }
+    }
+
+    exec.pinThreads(settings.affinity);
+    UnpinGuard<Executor> unpin(exec);
+
+    // each chunk initializes its own part of the pool
+    exec.run(maxChunks, [&](int c) {
+        int b, e;
+        chunkRange(maxBees, maxChunks, c, b, e);
+        initializePopulation(pop, b, e, settings, rngs[c]);
+    });
+
+    // evaluate the starting colony: the candidates are the initial gains
+    // and are always kept
+    pop.size = settings.numBees;
+    int startChunks = std::min(maxChunks, pop.size);
+    exec.run(startChunks, [&](int c) {
+        int b, e;
+        chunkRange(pop.size, startChunks, c, b, e);
+        for (int i = b; i < e; i++) pop.active[i] = 1;
+        chunkEvals[c] += evaluateRange(pop, b, e, num, numSize, den, denSize, settings, false);
+        replaceScouts(pop, b, e);
+        chunkBest[c] = findBest(pop, b, e);
+    });
+
+    int bestIndex = reduceBest(pop, chunkBest, startChunks);
+    bestMSE = pop.fitness[bestIndex];
+    bestParams.Kp = pop.Kp[bestIndex];
+    bestParams.Ki = pop.Ki[bestIndex];
+    bestParams.Kd = pop.Kd[bestIndex];
+
+    // refinement is started at the end of an iteration and merged at the
+    // end of the next one. A concurrent executor runs it on its own thread
+    // meanwhile, the sequential one right away; the jobs work on copied
+    // gains, so both give the same result.
+    std::vector<RefineJob> refineJobs;
+    std::future<void> refining;
+    bool refinePending = false;
+    long long refineEvals = 0;
+
+    double windowBest = bestMSE;   // best MSE at the last resize check
+
+
+    for (int iter = 0; iter < settings.maxIterations; iter++) {
+        const int n = pop.size;
+        const int chunks = std::min(maxChunks, n);
+
+        // 1) employed bees: phi-step from a random partner k != i
+        exec.run(chunks, [&](int c) {
+            int b, e;
+            chunkRange(n, chunks, c, b, e);
+            drawEmployed(pop, b, e, rngs[c]);
+            generateCandidates(pop, b, e, settings);
+            chunkEvals[c] += evaluateRange(pop, b, e, num, numSize, den, denSize, settings, true);
+            if (settings.selection != nullptr) {
+                settings.selection(iter, pop, b, e, settings.selectionUser);
+            }
+        });
+        exec.run(chunks, [&](int c) {
+            int b, e;
+            chunkRange(n, chunks, c, b, e);
+            greedySelect(pop, b, e);
+        });
+
+        // 2) onlooker bees: probability 1 / (1 + fitness) (fitness = MSE)
+        exec.run(chunks, [&](int c) {
+            int b, e;
+            chunkRange(n, chunks, c, b, e);
+            drawOnlookers(pop, b, e, rngs[c]);
+            generateCandidates(pop, b, e, settings);
+            chunkEvals[c] += evaluateRange(pop, b, e, num, numSize, den, denSize, settings, true);
+            if (settings.selection != nullptr) {
+                settings.selection(iter, pop, b, e, settings.selectionUser);
+            }
+        });
+
+        // 3) scouts touch their own chunk only, so they share a fork-join
+        //    with the onlooker greedy step and the chunk's best
+        exec.run(chunks, [&](int c) {
+            int b, e;
+            chunkRange(n, chunks, c, b, e);
+            greedySelect(pop, b, e);
+
+            drawScouts(pop, b, e, settings, rngs[c]);
+            chunkEvals[c] += evaluateRange(pop, b, e, num, numSize, den, denSize, settings, false);
+            replaceScouts(pop, b, e);
+
+            chunkBest[c] = findBest(pop, b, e);
+        });
+
+        int iterBest = reduceBest(pop, chunkBest, chunks);
+
+        // 4) local refinement of the top-k bees: merge the one started an
+        //    iteration ago
+        if (refinePending) {
+            if (refining.valid()) refining.get();
+            refineEvals += applyRefineJobs(pop, refineJobs);
+            refinePending = false;
+            iterBest = findBest(pop, 0, n);
+        }
+
+        updateBest(pop, iterBest, bestParams, bestMSE);
+
+        // 5) adaptive population, while no refinement holds bee indices
+        if (settings.adaptivePopulation && settings.adaptEvery > 0 &&
+            (iter + 1) % settings.adaptEvery == 0) {
+            double diversity = populationDiversity(pop, settings);
+            double rate = windowBest > 0.0 ? (windowBest - bestMSE) / windowBest : 0.0;
+            windowBest = bestMSE;
+
+            int step = std::max(1, (int)(settings.adaptStep * n));
+
+            bool converged = diversity < settings.diversityLow;
+            bool stalled = rate < settings.stallRate;
+
+            if ((converged || stalled) && n > minBees) {
+                // circling one basin or not improving: fewer bees do the same job
+                shrinkPopulation(pop, std::max(minBees, n - step));
+            } else if (!converged && !stalled && n < maxBees) {
+                // spread out and improving: add random bees [n, n + added)
+                int added = std::min(maxBees, n + step) - n;
+                int addChunks = std::min(maxChunks, added);
+                exec.run(addChunks, [&](int c) {
+                    int b, e;
+                    chunkRange(added, addChunks, c, b, e);
+                    b += n;
+                    e += n;
+                    initializePopulation(pop, b, e, settings, rngs[c]);
+                    for (int i = b; i < e; i++) pop.active[i] = 1;
+                    chunkEvals[c] += evaluateRange(pop, b, e, num, numSize, den, denSize, settings, false);
+                    replaceScouts(pop, b, e);
+                });
+                pop.size = n + added;
+                updateBest(pop, findBest(pop, 0, pop.size), bestParams, bestMSE);
+            }
+        }
+
+        if (settings.refineEvery > 0 && (iter + 1) % settings.refineEvery == 0) {
+            collectRefineJobs(pop, settings, refineJobs);
+            if (Executor::concurrent) {
+                refining = std::async(std::launch::async, [&]() {
+                    exec.unpinCurrentThread();   // not the pinned caller's CPU
+                    runRefineJobs(refineJobs, num, numSize, den, denSize, settings);
+                });
+            } else {
+                runRefineJobs(refineJobs, num, numSize, den, denSize, settings);
+            }
+            refinePending = true;
+        }
+
+        // no next iteration to overlap with: merge before the last log line,
+        // so its gains and evaluations are reported
+        if (refinePending && iter + 1 == settings.maxIterations) {
+            if (refining.valid()) refining.get();
+            refineEvals += applyRefineJobs(pop, refineJobs);
+            refinePending = false;
+            updateBest(pop, findBest(pop, 0, pop.size), bestParams, bestMSE);
+        }
+
+        long long evaluations = refineEvals;
+        for (int c = 0; c < maxChunks; c++) evaluations += chunkEvals[c];
+
+        if (logFile.is_open()) {
+            logToCSV(logFile, iter, bestParams, bestMSE, evaluations, pop.size);
+        }
+
+        if (settings.progress != nullptr) {
+            settings.progress(iter, bestMSE, evaluations, settings.progressUser);
+        }
+    }
+
+    if (logFile.is_open()) logFile.close();
+
+    if (settings.bestTrace != nullptr) {
+        simulatePID(bestParams, num, numSize, den, denSize,
+                    settings.dt, settings.simTime, *settings.bestTrace);
+    }
+
+    freePopulation(pop);
+}
+
+#endif // BCO_CORE_H
@@ -1,7 +1,7 @@
 #ifndef BCO_PARALLEL_H
 #define BCO_PARALLEL_H
 
-#include "bco.h"  // reuse BCOSettings, Bee, PIDParams
+#include "bco.h"  // reuse BCOSettings, PIDParams
 
 // Parallel BCO using OpenMP.
 // Same interface as runBCO, but with internal parallel loops.
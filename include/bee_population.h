@@ -0,0 +1,213 @@
+#ifndef BEE_POPULATION_H
+#define BEE_POPULATION_H
+
+#include "bco.h"
+#include "utils.h"
+
+// Alignment of every population array (one cache line)
+const int CACHE_LINE = 64;
+
+// Structure-of-arrays bee population.
+// Bee i is (Kp[i], Ki[i], Kd[i], fitness[i], trials[i]). Every field is its
+// own contiguous, cache-line aligned array, so the phase kernels below are
+// plain loops the compiler can vectorize, and no bee is ever copied.
+// The arrays hold `capacity` bees; the colony is bees [0, size), so it can
+// grow and shrink without reallocating.
+struct BeePopulation {
+    int size;       // bees in the colony
+    int capacity;   // bees allocated
+
+    double* Kp;
+    double* Ki;
+    double* Kd;
+    double* fitness;
+    int*    trials;
+
+    // candidate solutions of the current phase (one slot per bee)
+    double* candKp;
+    double* candKi;
+    double* candKd;
+    double* candFitness;
+
+    // random draws of the current phase
+    int*    partner;   // index k != i used in the phi-step
+    double* phi;       // phi in [-1, 1]
+    int*    active;    // 1 if bee i takes part in the phase
+};
+
+// Allocates all arrays for `capacity` bees in one aligned block
+// (contents uninitialized). The colony starts full (size = capacity).
+void allocatePopulation(BeePopulation& pop, int capacity);
+
+// Releases the block allocated by allocatePopulation().
+void freePopulation(BeePopulation& pop);
+
+// Random initial gains and reset counters for bees [begin, end).
+void initializePopulation(BeePopulation& pop, int begin, int end,
+                          const BCOSettings& settings, std::mt19937& rng);
+
+// Spread of the colony: per gain, standard deviation over [0, size)
+// divided by the width of its search range, averaged over Kp, Ki, Kd.
+// About 0.29 for uniform random gains, 0 when every bee is the same.
+double populationDiversity(const BeePopulation& pop, const BCOSettings& settings);
+
+// Keeps the newSize fittest bees, moved to [0, newSize) in their current
+// order, and sets size = newSize. Uses partner[] and active[] as scratch.
+void shrinkPopulation(BeePopulation& pop, int newSize);
+
+// Static chunk c of `chunks` equal parts of [0, n)
+inline void chunkRange(int n, int chunks, int c, int& begin, int& end)
+{
+    int size = n / chunks;
+    int extra = n % chunks;
+    begin = c * size + (c < extra ? c : extra);
+    end = begin + size + (c < extra ? 1 : 0);
+}
+
+
+// ---------------------------------------------------------------------
+// Phase kernels. All work on bees [begin, end) so the parallel backends
+// can hand each worker its own chunk. Draw kernels use the chunk's RNG.
+// ---------------------------------------------------------------------
+
+// Employed phase draws: every bee is active, with a random partner and phi.
+inline void drawEmployed(BeePopulation& pop, int begin, int end, std::mt19937& rng)
+{
+    for (int i = begin; i < end; i++) {
+        int k;
+        do {
+            k = randomInt(rng, 0, pop.size - 1);
+        } while (k == i);
+        pop.partner[i] = k;
+        pop.phi[i] = randomDouble(rng, -1.0, 1.0);
+        pop.active[i] = 1;
+    }
+}
+
+// Onlooker phase draws: bee i is picked with probability 1 / (1 + fitness).
+// Bees not picked keep partner = i and phi = 0 (candidate = current).
+inline void drawOnlookers(BeePopulation& pop, int begin, int end, std::mt19937& rng)
+{
+    for (int i = begin; i < end; i++) {
+        double prob = 1.0 / (1.0 + pop.fitness[i]);
+        if (randomDouble(rng, 0, 1) < prob) {
+            int k;
+            do {
+                k = randomInt(rng, 0, pop.size - 1);
+            } while (k == i);
+            pop.partner[i] = k;
+            pop.phi[i] = randomDouble(rng, -1.0, 1.0);
+            pop.active[i] = 1;
+        } else {
+            pop.partner[i] = i;
+            pop.phi[i] = 0.0;
+            pop.active[i] = 0;
+        }
+    }
+}
+
+// Scout phase draws: stagnated bees get fresh random candidates.
+inline void drawScouts(BeePopulation& pop, int begin, int end,
+                       const BCOSettings& settings, std::mt19937& rng)
+{
+    for (int i = begin; i < end; i++) {
+        pop.active[i] = (pop.trials[i] > settings.limit);
+        if (pop.active[i]) {
+            pop.candKp[i] = randomDouble(rng, settings.KpMin, settings.KpMax);
+            pop.candKi[i] = randomDouble(rng, settings.KiMin, settings.KiMax);
+            pop.candKd[i] = randomDouble(rng, settings.KdMin, settings.KdMax);
+        }
+    }
+}
+
+// theta' = clamp(theta + phi * (theta - theta_k)) for all bees in range
+inline void generateCandidates(BeePopulation& pop, int begin, int end,
+                               const BCOSettings& settings)
+{
+    const double* Kp = pop.Kp;
+    const double* Ki = pop.Ki;
+    const double* Kd = pop.Kd;
+    const int* partner = pop.partner;
+    const double* phi = pop.phi;
+    double* candKp = pop.candKp;
+    double* candKi = pop.candKi;
+    double* candKd = pop.candKd;
+
+    #pragma omp simd
+    for (int i = begin; i < end; i++) {
+        int k = partner[i];
+        double p  = Kp[i] + phi[i] * (Kp[i] - Kp[k]);
+        double ki = Ki[i] + phi[i] * (Ki[i] - Ki[k]);
+        double d  = Kd[i] + phi[i] * (Kd[i] - Kd[k]);
+
+        p  = p  < settings.KpMin ? settings.KpMin : (p  > settings.KpMax ? settings.KpMax : p);
+        ki = ki < settings.KiMin ? settings.KiMin : (ki > settings.KiMax ? settings.KiMax : ki);
+        d  = d  < settings.KdMin ? settings.KdMin : (d  > settings.KdMax ? settings.KdMax : d);
+
+        candKp[i] = p;
+        candKi[i] = ki;
+        candKd[i] = d;
+    }
+}
+
+// Greedy selection: keep the candidate if it is better, else count a trial.
+inline void greedySelect(BeePopulation& pop, int begin, int end)
+{
+    double* Kp = pop.Kp;
+    double* Ki = pop.Ki;
+    double* Kd = pop.Kd;
+    double* fitness = pop.fitness;
+    int* trials = pop.trials;
+    const double* candKp = pop.candKp;
+    const double* candKi = pop.candKi;
+    const double* candKd = pop.candKd;
+    const double* candFitness = pop.candFitness;
+    const int* active = pop.active;
+
+    #pragma omp simd
+    for (int i = begin; i < end; i++) {
+        bool better = active[i] && candFitness[i] < fitness[i];
+        Kp[i] = better ? candKp[i] : Kp[i];
+        Ki[i] = better ? candKi[i] : Ki[i];
+        Kd[i] = better ? candKd[i] : Kd[i];
+        fitness[i] = better ? candFitness[i] : fitness[i];
+        trials[i] = better ? 0 : trials[i] + active[i];
+    }
+}
+
+// Scout reset: active bees take their new candidate unconditionally.
+inline void replaceScouts(BeePopulation& pop, int begin, int end)
+{
+    double* Kp = pop.Kp;
+    double* Ki = pop.Ki;
+    double* Kd = pop.Kd;
+    double* fitness = pop.fitness;
+    int* trials = pop.trials;
+    const double* candKp = pop.candKp;
+    const double* candKi = pop.candKi;
+    const double* candKd = pop.candKd;
+    const double* candFitness = pop.candFitness;
+    const int* active = pop.active;
+
+    #pragma omp simd
+    for (int i = begin; i < end; i++) {
+        bool reset = active[i];
+        Kp[i] = reset ? candKp[i] : Kp[i];
+        Ki[i] = reset ? candKi[i] : Ki[i];
+        Kd[i] = reset ? candKd[i] : Kd[i];
+        fitness[i] = reset ? candFitness[i] : fitness[i];
+        trials[i] = reset ? 0 : trials[i];
+    }
+}
+
+// Index of the lowest fitness in range (first one on ties)
+inline int findBest(const BeePopulation& pop, int begin, int end)
+{
+    int best = begin;
+    for (int i = begin + 1; i < end; i++) {
+        if (pop.fitness[i] < pop.fitness[best]) best = i;
+    }
+    return best;
+}
+
+#endif // BEE_POPULATION_H
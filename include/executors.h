@@ -0,0 +1,119 @@
+#ifndef EXECUTORS_H
+#define EXECUTORS_H
+
+#include "affinity.h"
+#include "thread_pool.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Execution policies for the templated BCO core (bco_core.h).
+// The core splits the population into chunks() chunks and calls
+// run(count, f), which must call f(c) once for every c in [0, count)
+// and return when all calls are done (fork-join). Different chunks touch
+// disjoint bees, so f may run them concurrently.
+// concurrent = whether other work may overlap with the colony
+// (used to run local refinement asynchronously).
+// pinThreads(policy) pins the workers before the run and unpinThreads()
+// gives every one of them back the mask it had before (the workers
+// outlive the run). unpinCurrentThread() gives a thread outside the team
+// the caller's original mask: the refinement thread would otherwise
+// inherit the pinned one.
+
+
+// Plain loop on the calling thread: no threads, atomics or locks.
+struct SequentialExecutor {
+    static const bool concurrent = false;
+
+    int chunks() const { return 1; }
+    void pinThreads(AffinityPolicy) {}
+    void unpinThreads() {}
+    void unpinCurrentThread() {}
+
+    template <class F>
+    void run(int count, F&& f)
+    {
+        for (int c = 0; c < count; c++) f(c);
+    }
+};
+
+
+#ifdef _OPENMP
+// One chunk per OpenMP thread; chunk c always runs on thread c, so a
+// pinned thread keeps the same bees (and their cache lines) every phase.
+struct OpenMPExecutor {
+    static const bool concurrent = true;
+
+    int threads;
+    std::vector<SavedAffinity> saved;   // mask of team thread t before pinning
+
+    explicit OpenMPExecutor(int numThreads = omp_get_max_threads())
+        : threads(numThreads < 1 ? 1 : numThreads) {}
+
+    int chunks() const { return threads; }
+
+    // the calling thread is thread 0 of the team, so it gets pinned too
+    void pinThreads(AffinityPolicy policy)
+    {
+        if (policy == AFFINITY_NONE) return;
+
+        saved.assign(threads, SavedAffinity());
+        #pragma omp parallel num_threads(threads)
+        {
+            saved[omp_get_thread_num()] = saveAffinity();
+            pinCurrentThread(policy);
+        }
+    }
+
+    // libgomp keeps the same threads, in the same order, for a team of the
+    // same size, so thread t gets back the mask it saved
+    void unpinThreads()
+    {
+        if (saved.empty()) return;
+
+        #pragma omp parallel num_threads(threads)
+        restoreAffinity(saved[omp_get_thread_num()]);
+        saved.clear();
+    }
+
+    void unpinCurrentThread()
+    {
+        if (!saved.empty()) restoreAffinity(saved[0]);
+    }
+
+    template <class F>
+    void run(int count, F&& f)
+    {
+        #pragma omp parallel for schedule(static, 1) num_threads(threads)
+        for (int c = 0; c < count; c++) f(c);
+    }
+};
+#endif
+
+
+// Chunks per worker of the work-stealing pool: more chunks than workers
+// give idle workers something to steal.
+const int CHUNKS_PER_WORKER = 4;
+
+// Work-stealing thread pool (thread_pool.h). Pool threads are not OpenMP
+// threads, so affinity policies are ignored.
+struct WorkStealingExecutor {
+    static const bool concurrent = true;
+
+    WorkStealingPool pool;
+
+    explicit WorkStealingExecutor(int threads) : pool(threads) {}
+
+    int chunks() const { return pool.size() * CHUNKS_PER_WORKER; }
+    void pinThreads(AffinityPolicy) {}
+    void unpinThreads() {}
+    void unpinCurrentThread() {}
+
+    template <class F>
+    void run(int count, F&& f)
+    {
+        pool.parallelFor(count, f);
+    }
+};
+
+#endif // EXECUTORS_H
@@ -0,0 +1,51 @@
+#ifndef LOCAL_SEARCH_H
+#define LOCAL_SEARCH_H
+
+#include "bco.h"
+#include "bee_population.h"
+#include <vector>
+
+// Result of one local refinement
+struct LocalSearchResult {
+    PIDParams params;   // best gains found
+    double mse;         // their MSE
+    int evaluations;    // simulatePID calls spent
+};
+
+// Bounded Nelder-Mead simplex search in (Kp, Ki, Kd) starting from `start`
+// (whose MSE is already known). Vertices are clamped to the BCOSettings box.
+// Never runs more than settings.refineMaxEvals simulations (none if the
+// budget cannot pay for the initial simplex, 3) and stops early once the
+// simplex has collapsed.
+LocalSearchResult nelderMead(const PIDParams& start, double startMSE,
+                             const double* num, int numSize,
+                             const double* den, int denSize,
+                             const BCOSettings& settings);
+
+
+// One bee queued for refinement. Holds a copy of its gains, so the
+// search can run while the colony keeps changing.
+struct RefineJob {
+    int index;                  // bee the gains were taken from
+    PIDParams start;
+    double startMSE;
+    LocalSearchResult result;
+};
+
+// Queues the settings.refineTopK best bees of the population.
+void collectRefineJobs(const BeePopulation& pop, const BCOSettings& settings,
+                       std::vector<RefineJob>& jobs);
+
+// Runs Nelder-Mead on every queued job (touches no shared state).
+void runRefineJobs(std::vector<RefineJob>& jobs,
+                   const double* num, int numSize,
+                   const double* den, int denSize,
+                   const BCOSettings& settings);
+
+// Feeds refined gains that improved on their start back into the colony:
+// into the source bee if they beat its current fitness, else into the
+// worst bee if they beat that.
+// Returns the number of simulatePID calls the jobs spent.
+long long applyRefineJobs(BeePopulation& pop, const std::vector<RefineJob>& jobs);
+
+#endif // LOCAL_SEARCH_H
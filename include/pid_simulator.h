@@ -14,8 +14,28 @@ struct PIDResult {
     double finalValue;
 };
 
+// Floating-point policy of the simulation kernel
+enum Precision {
+    PRECISION_DOUBLE,   // double state, double MSE accumulator (reference)
+    PRECISION_FLOAT,    // float state, float MSE accumulator
+    PRECISION_MIXED     // float state, double MSE accumulator
+};
+
+struct TraceBuffer;   // trace.h
+
 // Function prototypes
 PIDResult simulatePID(const PIDParams& params, const double* num, int numSize,
                       const double* den, int denSize, double dt, double simTime);
 
+// Same simulation with the selected precision policy
+PIDResult simulatePID(const PIDParams& params, const double* num, int numSize,
+                      const double* den, int denSize, double dt, double simTime,
+                      Precision precision);
+
+// Same simulation (double precision) that also records y, u and error
+// into trace (see trace.h). The other overloads have no tracing code.
+PIDResult simulatePID(const PIDParams& params, const double* num, int numSize,
+                      const double* den, int denSize, double dt, double simTime,
+                      TraceBuffer& trace);
+
 #endif
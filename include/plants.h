@@ -0,0 +1,19 @@
+#ifndef PLANTS_H
+#define PLANTS_H
+
+#include <vector>
+
+// G1(s) = 1 / (s + 1)
+void getG1(std::vector<double>& num, std::vector<double>& den);
+
+// G2(s) = 5 / (s^2 + 2s + 5)
+void getG2(std::vector<double>& num, std::vector<double>& den);
+
+// G3(s) = 10 / ((s+1)(s^2 + 2s + 10))
+void getG3(std::vector<double>& num, std::vector<double>& den);
+
+// Loads G1, G2 or G3 by index (1, 2, 3).
+// Returns false if the index is out of range.
+bool getPlant(int plantIndex, std::vector<double>& num, std::vector<double>& den);
+
+#endif // PLANTS_H
@@ -0,0 +1,74 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include "pid_simulator.h"
+
+// Upper bound on scenarios per batch (fixed-size lanes, no allocation
+// inside the simulation)
+const int MAX_SCENARIOS = 64;
+
+// Highest plant order the batch kernels simulate
+const int MAX_ORDER = 3;
+
+// How per-scenario MSEs are combined into one fitness value
+enum ScenarioAggregate {
+    AGGREGATE_MEAN,    // mean MSE over all scenarios
+    AGGREGATE_WORST    // worst-case (max) MSE
+};
+
+// A batch of scenarios for one plant structure, stored as structure of
+// arrays: scenario s is lane s of every array. All scenarios share the
+// plant order; coefficients, reference and disturbance vary per lane.
+//
+// Plant lane s:  b[s] / (s^n + c1[s] s^(n-1) + ... + cn[s])
+// Reference:     refAmplitude * min(1, t / rampTime)   (rampTime 0 = step)
+// Disturbance:   loadSize added to the plant input for t >= loadTime
+struct ScenarioBatch {
+    int count;
+    int order;   // 1, 2 or 3 (denSize - 1)
+
+    alignas(64) double b[MAX_SCENARIOS];
+    alignas(64) double c1[MAX_SCENARIOS];
+    alignas(64) double c2[MAX_SCENARIOS];
+    alignas(64) double c3[MAX_SCENARIOS];
+
+    alignas(64) double refAmplitude[MAX_SCENARIOS];
+    alignas(64) double rampTime[MAX_SCENARIOS];
+    alignas(64) double loadTime[MAX_SCENARIOS];
+    alignas(64) double loadSize[MAX_SCENARIOS];
+};
+
+// Empty batch for a plant of the given order
+void initScenarioBatch(ScenarioBatch& batch, int order);
+
+// Appends one scenario. den has order+1 coefficients (den[0] = 1).
+// Returns false if the batch is full or its order is not 1 to MAX_ORDER.
+bool addScenario(ScenarioBatch& batch, const double* num, const double* den,
+                 double refAmplitude, double rampTime,
+                 double loadTime, double loadSize);
+
+// Default robust-tuning batch for num/den:
+//   plants      : nominal + every +-uncertainty corner of den[1..n]
+//   references  : unit step, half step, unit ramp over simTime/10
+//   disturbances: none, +0.5 load step at simTime/2
+// (G1: 3 x 3 x 2 = 18 scenarios, G2: 30, G3: 54)
+// Throws std::invalid_argument unless the plant order (denSize - 1) is
+// 1 to MAX_ORDER.
+void buildScenarioBatch(const double* num, int numSize,
+                        const double* den, int denSize,
+                        double uncertainty, double simTime,
+                        ScenarioBatch& batch);
+
+// Simulates one PID candidate against every scenario of the batch in
+// lockstep (scenarios in SIMD lanes) and returns the aggregate MSE.
+// Each scenario's MSE is normalized by refAmplitude^2; unstable
+// scenarios count as 1e9. Stops early, returning a value >= cutoff, as
+// soon as the aggregate can no longer go below cutoff.
+// precision selects the lane type as in simulatePID (float: twice the
+// lanes per SIMD vector).
+double simulatePIDBatch(const PIDParams& params, const ScenarioBatch& batch,
+                        double dt, double simTime,
+                        ScenarioAggregate aggregate, double cutoff,
+                        Precision precision = PRECISION_DOUBLE);
+
+#endif // SCENARIO_H
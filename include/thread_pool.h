@@ -0,0 +1,55 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+// Fixed-size work-stealing thread pool.
+// parallelFor() deals the task indices round-robin into one deque per
+// worker. A worker pops from the back of its own deque and, once that is
+// empty, steals from the front of the others, so workers that drew cheap
+// tasks (e.g. unstable candidates that bail out early) take over the rest.
+// The calling thread acts as worker 0.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threads);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // number of workers, including the calling thread
+    int size() const { return (int)queues.size(); }
+
+    // Runs task(i) for every i in [0, count); returns when all are done.
+    void parallelFor(int count, const std::function<void(int)>& task);
+
+private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<int> items;
+    };
+
+    bool take(int id, int& item);
+    bool runOne(int id);
+    void workerLoop(int id);
+
+    std::vector<Queue> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wake;   // new job or stop
+    std::condition_variable done;   // current job finished
+    bool stop;
+    long long job;                  // job counter, bumped by parallelFor
+
+    const std::function<void(int)>* task;
+    std::atomic<int> remaining;
+};
+
+#endif // THREAD_POOL_H
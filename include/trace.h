@@ -0,0 +1,65 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "pid_simulator.h"
+#include <cstddef>
+#include <cstdint>
+
+// Time series of one simulation (trace mode of simulatePID).
+// Every `decimation`-th step stores the plant output y, the controller
+// output u and the tracking error, one column per signal. Storage is
+// either caller-provided or mmap'd; simulatePID only writes into it,
+// it never allocates.
+struct TraceBuffer {
+    int capacity;       // samples per column
+    int decimation;     // keep every decimation-th step (1 = all)
+    int count;          // samples written by the last simulation
+    double sampleTime;  // seconds between samples (dt * decimation)
+    PIDParams params;   // gains of the traced simulation
+
+    double* y;
+    double* u;
+    double* error;
+
+    // mmap'd storage (see mapTraceBuffer); nullptr for caller storage
+    void* mapping;
+    size_t mappedBytes;
+    bool fileBacked;
+};
+
+// Header of the binary columnar trace file (64 bytes, native endianness).
+// It is followed by the columns y, u and error; column k starts at byte
+// 64 + k * capacity * 8 and its first `samples` doubles are valid.
+struct TraceFileHeader {
+    char magic[8];          // "BCOTRACE"
+    int32_t version;        // 1
+    int32_t columns;        // 3 (y, u, error)
+    int64_t samples;
+    int64_t capacity;
+    double sampleTime;
+    double Kp, Ki, Kd;
+};
+
+// Samples a simulation of simTime / dt steps records at this decimation
+int traceSamples(double dt, double simTime, int decimation);
+
+// Uses caller-provided arrays of `capacity` doubles each.
+void initTraceBuffer(TraceBuffer& trace, double* y, double* u, double* error,
+                     int capacity, int decimation);
+
+// Maps storage for `capacity` samples per column. With path == nullptr the
+// mapping is anonymous memory. Otherwise it is the trace file itself
+// (header + columns): simulatePID writes straight into the file's pages
+// and unmapTraceBuffer() completes the header, so exporting copies nothing.
+// Returns false if the file or mapping cannot be created.
+bool mapTraceBuffer(TraceBuffer& trace, int capacity, int decimation,
+                    const char* path);
+
+// Releases a mapped buffer; a file-backed one is finalized and flushed.
+void unmapTraceBuffer(TraceBuffer& trace);
+
+// Writes the trace (any storage) to a binary columnar file with
+// capacity = count. Returns false on I/O error.
+bool writeTraceFile(const char* path, const TraceBuffer& trace);
+
+#endif // TRACE_H
@@ -1,6 +1,8 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <random>
+
 // Call once at the beginning of main() to seed the RNG
 void initRandom(int baseSeed = 12345);
 
@@ -10,6 +12,11 @@ double randomDouble(double min, double max);
 // Random integer in [min, max] (inclusive)
 int randomInt(int min, int max);
 
+// Same draws from an explicit generator. The optimizer keeps one generator
+// per population chunk, so results do not depend on which thread runs it.
+double randomDouble(std::mt19937& gen, double min, double max);
+int randomInt(std::mt19937& gen, int min, int max);
+
 // Clamp value to [min, max]
 double clamp(double value, double min, double max);
 
@@ -3,12 +3,17 @@
 # ------------------------------
 # For: bco_parallel
 # Generates: parallel_results.csv
+#
+# ./run_experiments.sh           thread sweep (default placement)
+# ./run_experiments.sh affinity  also scaling report from 1 to all
+#                                cores per pinning policy
+#                                -> affinity_results.csv
 # ------------------------------
 
 OUTPUT_FILE="parallel_results.csv"
 
 # Header
-echo "threads,plant,time" > $OUTPUT_FILE
+echo "threads,plant,time,affinity" > $OUTPUT_FILE
 
 # Thread counts to test
 THREADS=(1 2 4 6 8 10)
@@ -23,12 +28,39 @@ for t in "${THREADS[@]}"; do
         echo "Running: threads=$t plant=G$p"
 
         # Run in CSV mode so it prints:
-        # threads,plant,time,checksum
+        # threads,plant,time,affinity
         ./bco_parallel $t $p C >> $OUTPUT_FILE
         sleep 0.5   # small delay
     done
 done
 
+# ------------------------------
+# Affinity scaling report
+# ------------------------------
+if [ "$1" == "affinity" ]; then
+
+    AFFINITY_FILE="affinity_results.csv"
+    echo "threads,plant,time,affinity" > $AFFINITY_FILE
+
+    # 1 .. all cores
+    MAX_THREADS=$(nproc)
+    POLICIES=(none compact scatter)
+
+    for a in "${POLICIES[@]}"; do
+        for t in $(seq 1 $MAX_THREADS); do
+            for p in "${PLANTS[@]}"; do
+
+                echo "Running: affinity=$a threads=$t plant=G$p"
+
+                ./bco_parallel $t $p C $a >> $AFFINITY_FILE
+                sleep 0.5
+            done
+        done
+    done
+
+    echo "Affinity results saved to $AFFINITY_FILE"
+fi
+
 echo "---------------------------------------"
 echo "All experiments completed!"
 echo "Results saved to $OUTPUT_FILE"
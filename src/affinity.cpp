@@ -0,0 +1,172 @@
+#include "affinity.h"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <omp.h>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+using namespace std;
+
+
+// one CPU the process may run on
+struct CpuInfo {
+    int cpu;
+    int socket;
+};
+
+
+// CPUs in the process mask with their socket id
+static vector<CpuInfo> readAllowedCpus()
+{
+    vector<CpuInfo> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) return cpus;
+
+    for (int c = 0; c < CPU_SETSIZE; c++) {
+        if (!CPU_ISSET(c, &set)) continue;
+
+        CpuInfo info;
+        info.cpu = c;
+        info.socket = 0;   // single socket if topology is not available
+
+        string path = "/sys/devices/system/cpu/cpu" + to_string(c) +
+                      "/topology/physical_package_id";
+        ifstream in(path.c_str());
+        if (in.is_open()) in >> info.socket;
+
+        cpus.push_back(info);
+    }
+#endif
+    return cpus;
+}
+
+// Read once, before any thread has been pinned (pinning the master thread
+// narrows the mask that later sched_getaffinity calls would see)
+static const vector<CpuInfo>& allowedCpus()
+{
+    static const vector<CpuInfo> cpus = readAllowedCpus();
+    return cpus;
+}
+
+// CPU ids ordered by (socket, cpu)
+static vector<int> compactOrder()
+{
+    vector<CpuInfo> cpus = allowedCpus();
+    stable_sort(cpus.begin(), cpus.end(), [](const CpuInfo& a, const CpuInfo& b) {
+        return a.socket != b.socket ? a.socket < b.socket : a.cpu < b.cpu;
+    });
+
+    vector<int> order;
+    for (const CpuInfo& c : cpus) order.push_back(c.cpu);
+    return order;
+}
+
+// CPU ids taking one from each socket in turn
+static vector<int> scatterOrder()
+{
+    vector<CpuInfo> cpus = allowedCpus();
+    stable_sort(cpus.begin(), cpus.end(), [](const CpuInfo& a, const CpuInfo& b) {
+        return a.socket != b.socket ? a.socket < b.socket : a.cpu < b.cpu;
+    });
+
+    // split per socket
+    vector<vector<int>> perSocket;
+    for (size_t i = 0; i < cpus.size(); i++) {
+        if (i == 0 || cpus[i].socket != cpus[i - 1].socket) perSocket.push_back(vector<int>());
+        perSocket.back().push_back(cpus[i].cpu);
+    }
+
+    vector<int> order;
+    for (size_t round = 0; order.size() < cpus.size(); round++) {
+        for (const vector<int>& s : perSocket) {
+            if (round < s.size()) order.push_back(s[round]);
+        }
+    }
+    return order;
+}
+
+
+void pinCurrentThread(AffinityPolicy policy)
+{
+    if (policy == AFFINITY_NONE) return;
+
+#ifdef __linux__
+    static const vector<int> compact = compactOrder();
+    static const vector<int> scatter = scatterOrder();
+
+    const vector<int>& order = (policy == AFFINITY_COMPACT) ? compact : scatter;
+    if (order.empty()) return;
+
+    int tid = omp_get_thread_num();
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(order[tid % order.size()], &set);
+    sched_setaffinity(0, sizeof(set), &set);   // 0 = calling thread
+#endif
+}
+
+
+SavedAffinity saveAffinity()
+{
+    SavedAffinity saved;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) return saved;
+
+    for (int c = 0; c < CPU_SETSIZE; c++) {
+        if (CPU_ISSET(c, &set)) saved.cpus.push_back(c);
+    }
+#endif
+    return saved;
+}
+
+
+void restoreAffinity(const SavedAffinity& saved)
+{
+    if (saved.cpus.empty()) return;
+
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c : saved.cpus) CPU_SET(c, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+#endif
+}
+
+
+int socketCount()
+{
+    const vector<CpuInfo>& cpus = allowedCpus();
+    vector<int> sockets;
+    for (const CpuInfo& c : cpus) {
+        if (find(sockets.begin(), sockets.end(), c.socket) == sockets.end())
+            sockets.push_back(c.socket);
+    }
+    return sockets.empty() ? 1 : (int)sockets.size();
+}
+
+
+bool parseAffinity(const char* text, AffinityPolicy& policy)
+{
+    if (strcmp(text, "none") == 0) policy = AFFINITY_NONE;
+    else if (strcmp(text, "compact") == 0) policy = AFFINITY_COMPACT;
+    else if (strcmp(text, "scatter") == 0) policy = AFFINITY_SCATTER;
+    else return false;
+    return true;
+}
+
+
+const char* affinityName(AffinityPolicy policy)
+{
+    if (policy == AFFINITY_COMPACT) return "compact";
+    if (policy == AFFINITY_SCATTER) return "scatter";
+    return "none";
+}
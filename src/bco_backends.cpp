@@ -0,0 +1,79 @@
+#include "bco_backends.h"
+#include "bco_core.h"
+#include <vector>
+#include <numeric>     // iota
+#include <algorithm>   // for_each
+#include <execution>
+#include <cstring>
+using namespace std;
+
+
+// C++17 parallel algorithms: chunks are handed to std::for_each with the
+// par_unseq policy (libstdc++ runs it on TBB, so link with -ltbb).
+struct StdParExecutor {
+    static const bool concurrent = true;
+
+    vector<int> ids;
+
+    explicit StdParExecutor(int numChunks) : ids(numChunks < 1 ? 1 : numChunks)
+    {
+        iota(ids.begin(), ids.end(), 0);
+    }
+
+    int chunks() const { return (int)ids.size(); }
+    void pinThreads(AffinityPolicy) {}
+    void unpinThreads() {}
+    void unpinCurrentThread() {}
+
+    template <class F>
+    void run(int count, F&& f)
+    {
+        for_each(execution::par_unseq, ids.begin(), ids.begin() + count,
+                 [&](int c) { f(c); });
+    }
+};
+
+
+bool parseBackend(const char* text, ExecutionBackend& backend)
+{
+    if (strcmp(text, "seq") == 0)    { backend = BACKEND_SEQUENTIAL;   return true; }
+    if (strcmp(text, "omp") == 0)    { backend = BACKEND_OPENMP;       return true; }
+    if (strcmp(text, "stdpar") == 0) { backend = BACKEND_STDPAR;       return true; }
+    if (strcmp(text, "ws") == 0)     { backend = BACKEND_WORKSTEALING; return true; }
+    return false;
+}
+
+const char* backendName(ExecutionBackend backend)
+{
+    switch (backend) {
+        case BACKEND_SEQUENTIAL:   return "seq";
+        case BACKEND_OPENMP:       return "omp";
+        case BACKEND_STDPAR:       return "stdpar";
+        case BACKEND_WORKSTEALING: return "ws";
+    }
+    return "unknown";
+}
+
+
+void runBCOWithBackend(ExecutionBackend backend, int threads,
+                       const double* num, int numSize,
+                       const double* den, int denSize,
+                       const BCOSettings& settings,
+                       PIDParams& bestParams,
+                       double& bestMSE,
+                       const char* logFilePath)
+{
+    if (backend == BACKEND_OPENMP) {
+        OpenMPExecutor exec(threads);
+        runBCOCore(exec, num, numSize, den, denSize, settings, bestParams, bestMSE, logFilePath);
+    } else if (backend == BACKEND_STDPAR) {
+        StdParExecutor exec(threads);
+        runBCOCore(exec, num, numSize, den, denSize, settings, bestParams, bestMSE, logFilePath);
+    } else if (backend == BACKEND_WORKSTEALING) {
+        WorkStealingExecutor exec(threads);
+        runBCOCore(exec, num, numSize, den, denSize, settings, bestParams, bestMSE, logFilePath);
+    } else {
+        SequentialExecutor exec;
+        runBCOCore(exec, num, numSize, den, denSize, settings, bestParams, bestMSE, logFilePath);
+    }
+}
@@ -0,0 +1,140 @@
+#include "bee_population.h"
+#include <cstdlib>   // aligned_alloc, free
+#include <new>       // bad_alloc
+#include <cmath>
+#include <algorithm> // nth_element
+
+using namespace std;
+
+
+// round a byte count up to a whole number of cache lines
+static size_t padToCacheLine(size_t bytes)
+{
+    return (bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+}
+
+
+// allocate population arrays
+void allocatePopulation(BeePopulation& pop, int capacity)
+{
+    size_t dbl = padToCacheLine(capacity * sizeof(double));
+    size_t in  = padToCacheLine(capacity * sizeof(int));
+
+    // 9 double arrays + 3 int arrays, each starting on its own cache line
+    size_t total = 9 * dbl + 3 * in;
+    if (total == 0) total = CACHE_LINE;
+
+    char* block = (char*)aligned_alloc(CACHE_LINE, total);
+    if (block == nullptr) throw bad_alloc();
+
+    pop.size = capacity;
+    pop.capacity = capacity;
+
+    pop.Kp          = (double*)block; block += dbl;
+    pop.Ki          = (double*)block; block += dbl;
+    pop.Kd          = (double*)block; block += dbl;
+    pop.fitness     = (double*)block; block += dbl;
+    pop.candKp      = (double*)block; block += dbl;
+    pop.candKi      = (double*)block; block += dbl;
+    pop.candKd      = (double*)block; block += dbl;
+    pop.candFitness = (double*)block; block += dbl;
+    pop.phi         = (double*)block; block += dbl;
+    pop.trials      = (int*)block;    block += in;
+    pop.partner     = (int*)block;    block += in;
+    pop.active      = (int*)block;
+}
+
+
+// free population arrays
+void freePopulation(BeePopulation& pop)
+{
+    free(pop.Kp);    // start of the block
+    pop.Kp = pop.Ki = pop.Kd = pop.fitness = nullptr;
+    pop.candKp = pop.candKi = pop.candKd = pop.candFitness = nullptr;
+    pop.phi = nullptr;
+    pop.trials = pop.partner = pop.active = nullptr;
+    pop.size = 0;
+    pop.capacity = 0;
+}
+
+
+// initialize bees [begin, end)
+void initializePopulation(BeePopulation& pop, int begin, int end,
+                          const BCOSettings& settings, mt19937& rng)
+{
+    for (int i = begin; i < end; i++) {
+        pop.Kp[i] = randomDouble(rng, settings.KpMin, settings.KpMax);
+        pop.Ki[i] = randomDouble(rng, settings.KiMin, settings.KiMax);
+        pop.Kd[i] = randomDouble(rng, settings.KdMin, settings.KdMax);
+
+        pop.fitness[i] = 1e9;   // large number
+        pop.trials[i] = 0;
+
+        pop.candKp[i] = pop.Kp[i];
+        pop.candKi[i] = pop.Ki[i];
+        pop.candKd[i] = pop.Kd[i];
+        pop.candFitness[i] = 1e9;
+
+        pop.partner[i] = i;
+        pop.phi[i] = 0.0;
+        pop.active[i] = 0;
+    }
+}
+
+
+// standard deviation of x[0..n) divided by range
+static double normalizedSpread(const double* x, int n, double range)
+{
+    double mean = 0.0;
+    for (int i = 0; i < n; i++) mean += x[i];
+    mean /= n;
+
+    double var = 0.0;
+    for (int i = 0; i < n; i++) var += (x[i] - mean) * (x[i] - mean);
+    var /= n;
+
+    return range > 0.0 ? sqrt(var) / range : 0.0;
+}
+
+double populationDiversity(const BeePopulation& pop, const BCOSettings& settings)
+{
+    if (pop.size <= 0) return 0.0;
+
+    double d = normalizedSpread(pop.Kp, pop.size, settings.KpMax - settings.KpMin)
+             + normalizedSpread(pop.Ki, pop.size, settings.KiMax - settings.KiMin)
+             + normalizedSpread(pop.Kd, pop.size, settings.KdMax - settings.KdMin);
+    return d / 3.0;
+}
+
+
+// keep the newSize fittest bees
+void shrinkPopulation(BeePopulation& pop, int newSize)
+{
+    if (newSize >= pop.size) return;
+
+    // rank indices by fitness (ties by index) in the partner scratch array
+    int* order = pop.partner;
+    for (int i = 0; i < pop.size; i++) order[i] = i;
+    nth_element(order, order + newSize, order + pop.size,
+                [&](int a, int b) {
+                    if (pop.fitness[a] != pop.fitness[b]) return pop.fitness[a] < pop.fitness[b];
+                    return a < b;
+                });
+
+    int* keep = pop.active;
+    for (int i = 0; i < pop.size; i++) keep[i] = 0;
+    for (int r = 0; r < newSize; r++) keep[order[r]] = 1;
+
+    // compact survivors to the front; j <= i, so nothing is overwritten early
+    int j = 0;
+    for (int i = 0; i < pop.size; i++) {
+        if (!keep[i]) continue;
+        pop.Kp[j] = pop.Kp[i];
+        pop.Ki[j] = pop.Ki[i];
+        pop.Kd[j] = pop.Kd[i];
+        pop.fitness[j] = pop.fitness[i];
+        pop.trials[j] = pop.trials[i];
+        j++;
+    }
+    pop.size = newSize;
+}
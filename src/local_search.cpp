@@ -0,0 +1,240 @@
+#include "local_search.h"
+#include "utils.h"
+#include <algorithm>
+#include <cmath>     // HUGE_VAL
+
+using namespace std;
+
+
+// Nelder-Mead coefficients (standard values)
+const double NM_REFLECT  = 1.0;
+const double NM_EXPAND   = 2.0;
+const double NM_CONTRACT = 0.5;
+const double NM_SHRINK   = 0.5;
+
+// stop once the spread of the simplex falls below this
+const double NM_TOLERANCE = 1e-12;
+
+
+// simplex vertex: gains + MSE
+struct Vertex {
+    double x[3];
+    double f;
+};
+
+
+static void clampVertex(Vertex& v, const BCOSettings& settings)
+{
+    v.x[0] = clamp(v.x[0], settings.KpMin, settings.KpMax);
+    v.x[1] = clamp(v.x[1], settings.KiMin, settings.KiMax);
+    v.x[2] = clamp(v.x[2], settings.KdMin, settings.KdMax);
+}
+
+static void evaluateVertex(Vertex& v, int& evals,
+                           const double* num, int numSize,
+                           const double* den, int denSize,
+                           const BCOSettings& settings)
+{
+    PIDParams params;
+    params.Kp = v.x[0];
+    params.Ki = v.x[1];
+    params.Kd = v.x[2];
+
+    v.f = evaluateFitness(params, num, numSize, den, denSize, settings, HUGE_VAL);
+    evals++;
+}
+
+// point = c + t * (p - c), clamped to the search box
+static Vertex along(const double c[3], const Vertex& p, double t,
+                    const BCOSettings& settings)
+{
+    Vertex v;
+    for (int d = 0; d < 3; d++) v.x[d] = c[d] + t * (p.x[d] - c[d]);
+    clampVertex(v, settings);
+    return v;
+}
+
+// insertion sort of the 4 vertices by MSE
+static void sortSimplex(Vertex s[4])
+{
+    for (int i = 1; i < 4; i++) {
+        Vertex v = s[i];
+        int j = i - 1;
+        while (j >= 0 && s[j].f > v.f) {
+            s[j + 1] = s[j];
+            j--;
+        }
+        s[j + 1] = v;
+    }
+}
+
+
+LocalSearchResult nelderMead(const PIDParams& start, double startMSE,
+                             const double* num, int numSize,
+                             const double* den, int denSize,
+                             const BCOSettings& settings)
+{
+    const double lo[3] = {settings.KpMin, settings.KiMin, settings.KdMin};
+    const double hi[3] = {settings.KpMax, settings.KiMax, settings.KdMax};
+
+    int evals = 0;
+    int maxEvals = settings.refineMaxEvals;
+
+    // the initial simplex alone costs 3 simulations
+    if (maxEvals < 3) {
+        LocalSearchResult result;
+        result.params = start;
+        result.mse = startMSE;
+        result.evaluations = 0;
+        return result;
+    }
+
+    // initial simplex: start + one step along each axis (pointing inwards)
+    Vertex s[4];
+    s[0].x[0] = start.Kp;
+    s[0].x[1] = start.Ki;
+    s[0].x[2] = start.Kd;
+    s[0].f = startMSE;
+
+    for (int d = 0; d < 3; d++) {
+        s[d + 1] = s[0];
+        double step = settings.refineStep * (hi[d] - lo[d]);
+        if (s[0].x[d] + step > hi[d]) step = -step;
+        s[d + 1].x[d] += step;
+        clampVertex(s[d + 1], settings);
+        evaluateVertex(s[d + 1], evals, num, numSize, den, denSize, settings);
+    }
+
+    while (evals < maxEvals) {
+        sortSimplex(s);
+
+        if (s[3].f - s[0].f < NM_TOLERANCE) break;
+
+        // centroid of the 3 best vertices
+        double c[3];
+        for (int d = 0; d < 3; d++) c[d] = (s[0].x[d] + s[1].x[d] + s[2].x[d]) / 3.0;
+
+        Vertex r = along(c, s[3], -NM_REFLECT, settings);
+        evaluateVertex(r, evals, num, numSize, den, denSize, settings);
+
+        if (r.f < s[0].f) {
+            // try to go further in the same direction (budget permitting)
+            Vertex best = r;
+            if (evals < maxEvals) {
+                Vertex e = along(c, s[3], -NM_EXPAND, settings);
+                evaluateVertex(e, evals, num, numSize, den, denSize, settings);
+                if (e.f < r.f) best = e;
+            }
+            s[3] = best;
+        }
+        else if (r.f < s[2].f) {
+            s[3] = r;
+        }
+        else {
+            // out of budget: keep the reflection if it improves the worst
+            if (evals >= maxEvals) {
+                if (r.f < s[3].f) s[3] = r;
+                break;
+            }
+
+            // contract towards the better of worst / reflected
+            const Vertex& base = (r.f < s[3].f) ? r : s[3];
+            Vertex k = along(c, base, NM_CONTRACT, settings);
+            evaluateVertex(k, evals, num, numSize, den, denSize, settings);
+
+            if (k.f < base.f) {
+                s[3] = k;
+            } else {
+                // shrink everything towards the best vertex (needs 3 evaluations)
+                if (evals + 3 > maxEvals) break;
+                for (int i = 1; i < 4; i++) {
+                    for (int d = 0; d < 3; d++)
+                        s[i].x[d] = s[0].x[d] + NM_SHRINK * (s[i].x[d] - s[0].x[d]);
+                    evaluateVertex(s[i], evals, num, numSize, den, denSize, settings);
+                }
+            }
+        }
+    }
+
+    sortSimplex(s);
+
+    LocalSearchResult result;
+    result.params.Kp = s[0].x[0];
+    result.params.Ki = s[0].x[1];
+    result.params.Kd = s[0].x[2];
+    result.mse = s[0].f;
+    result.evaluations = evals;
+    return result;
+}
+
+
+// queue the top-k bees
+void collectRefineJobs(const BeePopulation& pop, const BCOSettings& settings,
+                       vector<RefineJob>& jobs)
+{
+    int k = min(settings.refineTopK, pop.size);
+    jobs.clear();
+    if (k <= 0) return;
+
+    vector<int> order(pop.size);
+    for (int i = 0; i < pop.size; i++) order[i] = i;
+    partial_sort(order.begin(), order.begin() + k, order.end(),
+                 [&](int a, int b) { return pop.fitness[a] < pop.fitness[b]; });
+
+    for (int j = 0; j < k; j++) {
+        int i = order[j];
+        RefineJob job;
+        job.index = i;
+        job.start.Kp = pop.Kp[i];
+        job.start.Ki = pop.Ki[i];
+        job.start.Kd = pop.Kd[i];
+        job.startMSE = pop.fitness[i];
+        jobs.push_back(job);
+    }
+}
+
+
+// run all queued refinements
+void runRefineJobs(vector<RefineJob>& jobs,
+                   const double* num, int numSize,
+                   const double* den, int denSize,
+                   const BCOSettings& settings)
+{
+    for (size_t j = 0; j < jobs.size(); j++) {
+        jobs[j].result = nelderMead(jobs[j].start, jobs[j].startMSE,
+                                    num, numSize, den, denSize, settings);
+    }
+}
+
+
+// write refined gains back into the population
+long long applyRefineJobs(BeePopulation& pop, const vector<RefineJob>& jobs)
+{
+    long long evals = 0;
+
+    for (size_t j = 0; j < jobs.size(); j++) {
+        const LocalSearchResult& r = jobs[j].result;
+        evals += r.evaluations;
+
+        // nothing found: writing the start back would clone the best bee
+        if (!(r.mse < jobs[j].startMSE)) continue;
+
+        int slot = jobs[j].index;
+        if (!(r.mse < pop.fitness[slot])) {
+            // source bee moved on (improved or scouted): try the worst bee
+            slot = 0;
+            for (int i = 1; i < pop.size; i++) {
+                if (pop.fitness[i] > pop.fitness[slot]) slot = i;
+            }
+            if (!(r.mse < pop.fitness[slot])) continue;
+        }
+
+        pop.Kp[slot] = r.params.Kp;
+        pop.Ki[slot] = r.params.Ki;
+        pop.Kd[slot] = r.params.Kd;
+        pop.fitness[slot] = r.mse;
+        pop.trials[slot] = 0;
+    }
+
+    return evals;
+}
@@ -0,0 +1,337 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <omp.h>
+
+#include "bco.h"
+#include "bco_backends.h"
+#include "plants.h"
+
+using namespace std;
+
+
+const double INF = numeric_limits<double>::infinity();
+
+// z value of the 95% confidence interval for the median
+const double Z95 = 1.96;
+
+
+// One point of the best-MSE-vs-time trajectory
+struct TracePoint {
+    int iteration;
+    double time;            // seconds since the run started
+    long long evaluations;
+    double bestMSE;
+};
+
+// One run = one (configuration, seed)
+struct BenchRun {
+    ExecutionBackend backend;
+    int threads;            // 0 for the sequential backend
+    int seed;
+    double totalTime;
+    vector<TracePoint> trace;
+};
+
+// Progress callback state
+struct TraceRecorder {
+    double start;
+    vector<TracePoint>* trace;
+};
+
+void recordProgress(int iteration, double bestMSE, long long evaluations, void* user)
+{
+    TraceRecorder* rec = (TraceRecorder*)user;
+    TracePoint p;
+    p.iteration = iteration;
+    p.time = omp_get_wtime() - rec->start;
+    p.evaluations = evaluations;
+    p.bestMSE = bestMSE;
+    rec->trace->push_back(p);
+}
+
+
+// first point of the trajectory at or below target (nullptr if never reached)
+const TracePoint* firstReaching(const BenchRun& run, double target)
+{
+    for (size_t i = 0; i < run.trace.size(); i++) {
+        if (run.trace[i].bestMSE <= target) return &run.trace[i];
+    }
+    return nullptr;
+}
+
+double median(vector<double> v)
+{
+    if (v.empty()) return INF;
+    sort(v.begin(), v.end());
+    size_t n = v.size();
+    if (n % 2 == 1) return v[n / 2];
+    return 0.5 * (v[n / 2 - 1] + v[n / 2]);
+}
+
+// Distribution-free 95% CI of the median from order statistics
+// (normal approximation of the binomial ranks). Works with +inf entries.
+void medianCI(vector<double> v, double& low, double& high)
+{
+    if (v.empty()) {
+        low = high = INF;
+        return;
+    }
+    sort(v.begin(), v.end());
+    int n = (int)v.size();
+    double half = Z95 * sqrt((double)n) / 2.0;
+    int lo = (int)floor(n / 2.0 - half);
+    int hi = (int)ceil(n / 2.0 + half);
+    lo = max(lo, 1);
+    hi = min(hi, n);
+    low = v[lo - 1];
+    high = v[hi - 1];
+}
+
+// One benchmark configuration
+struct BenchConfig {
+    ExecutionBackend backend;
+    int threads;
+};
+
+// "1,2,4" -> {1, 2, 4}
+bool parseThreadList(const string& text, vector<int>& out)
+{
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        int t = atoi(item.c_str());
+        if (t <= 0) return false;
+        out.push_back(t);
+    }
+    return !out.empty();
+}
+
+// "seq,omp,ws" -> backends
+bool parseBackendList(const string& text, vector<ExecutionBackend>& out)
+{
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        ExecutionBackend b;
+        if (!parseBackend(item.c_str(), b)) return false;
+        out.push_back(b);
+    }
+    return !out.empty();
+}
+
+
+// Usage: ./bco_benchmark <plantIndex{1,2,3}> <seeds> <threadList> [targetMSE|auto] [maxIterations] [outPrefix] [backendList] [fixed|adaptive]
+// Runs every backend in backendList (seq,omp,stdpar,ws; default seq,omp)
+// for every thread count in threadList (e.g. 1,2,4,8; seq runs once),
+// <seeds> times each, and writes
+//   <outPrefix>_trajectories.csv : best MSE vs time/evaluations per run
+//   <outPrefix>_summary.csv      : time-to-target statistics per configuration
+// auto target = worst final MSE over all runs, so every run reaches it.
+// adaptive turns on BCOSettings::adaptivePopulation; to compare it with
+// fixed, run both with the same explicit targetMSE.
+int main(int argc, char* argv[])
+{
+    if (argc < 4 || argc > 9) {
+        cout << "Usage: " << argv[0]
+             << " <plantIndex{1,2,3}> <seeds> <threadList> [targetMSE|auto] [maxIterations] [outPrefix] [backendList] [fixed|adaptive]"
+             << endl;
+        return 1;
+    }
+
+    int plantIndex = atoi(argv[1]);
+    int seeds = atoi(argv[2]);
+    vector<int> threadList;
+    string targetArg = (argc >= 5 ? argv[4] : "auto");
+    int maxIterations = (argc >= 6 ? atoi(argv[5]) : 500);
+    string prefix = (argc >= 7 ? argv[6] : "benchmark");
+    vector<ExecutionBackend> backends;
+    string population = (argc >= 9 ? argv[8] : "fixed");
+
+    if (plantIndex < 1 || plantIndex > 3) {
+        cout << "Error: plant index must be 1, 2, or 3\n";
+        return 1;
+    }
+    if (seeds <= 0) {
+        cout << "Error: seeds must be > 0\n";
+        return 1;
+    }
+    if (!parseThreadList(argv[3], threadList)) {
+        cout << "Error: threadList must be positive integers, e.g. 1,2,4\n";
+        return 1;
+    }
+    if (!parseBackendList(argc >= 8 ? argv[7] : "seq,omp", backends)) {
+        cout << "Error: backendList must be seq, omp, stdpar or ws, e.g. seq,omp,ws\n";
+        return 1;
+    }
+    if (population != "fixed" && population != "adaptive") {
+        cout << "Error: population must be fixed or adaptive\n";
+        return 1;
+    }
+    if (maxIterations <= 0) {
+        cout << "Error: maxIterations must be > 0\n";
+        return 1;
+    }
+
+    vector<double> num, den;
+    getPlant(plantIndex, num, den);
+
+    // BCO Settings (same as main_parallel)
+    BCOSettings settings;
+    settings.numBees = 100;
+    settings.maxIterations = maxIterations;
+    settings.limit = 30;
+
+    settings.KpMin = -10.0;  settings.KpMax = 10.0;
+    settings.KiMin = -10.0;  settings.KiMax = 10.0;
+    settings.KdMin = -10.0;  settings.KdMax = 10.0;
+
+    settings.dt = 0.001;
+    settings.simTime = 40.0;
+
+    // adaptive: colony resized within [20, 200] (BCOSettings defaults)
+    settings.adaptivePopulation = (population == "adaptive");
+
+    // configurations: each backend at each thread count; seq runs once
+    // and goes first, as the speedup baseline
+    vector<BenchConfig> configs;
+    for (ExecutionBackend b : backends) {
+        if (b == BACKEND_SEQUENTIAL) {
+            configs.insert(configs.begin(), {b, 0});
+            continue;
+        }
+        for (int t : threadList) configs.push_back({b, t});
+    }
+
+    vector<BenchRun> runs;
+
+    for (const BenchConfig& c : configs) {
+        for (int s = 0; s < seeds; s++) {
+            BenchRun run;
+            run.backend = c.backend;
+            run.threads = c.threads;
+            run.seed = 12345 + 1000 * s;
+
+            TraceRecorder rec;
+            rec.trace = &run.trace;
+
+            BCOSettings runSettings = settings;
+            runSettings.seed = run.seed;
+            runSettings.progress = recordProgress;
+            runSettings.progressUser = &rec;
+
+            PIDParams bestPID;
+            double bestMSE = 1e9;
+
+            rec.start = omp_get_wtime();
+            runBCOWithBackend(c.backend, c.threads,
+                              num.data(), num.size(), den.data(), den.size(),
+                              runSettings, bestPID, bestMSE, nullptr);
+            run.totalTime = omp_get_wtime() - rec.start;
+
+            cout << backendName(c.backend) << " threads=" << c.threads << " seed=" << run.seed
+                 << " MSE=" << bestMSE << " time=" << run.totalTime << "s\n";
+
+            runs.push_back(run);
+        }
+    }
+
+    // Target MSE
+    double target;
+    if (targetArg == "auto") {
+        target = 0.0;
+        for (const BenchRun& r : runs) {
+            if (!r.trace.empty()) target = max(target, r.trace.back().bestMSE);
+        }
+    } else {
+        target = atof(targetArg.c_str());
+    }
+
+    // Trajectories
+    ofstream traj((prefix + "_trajectories.csv").c_str());
+    traj << "plant,mode,threads,seed,iteration,time,evaluations,bestMSE\n";
+    for (const BenchRun& r : runs) {
+        for (const TracePoint& p : r.trace) {
+            traj << plantIndex << ","
+                 << backendName(r.backend) << ","
+                 << r.threads << ","
+                 << r.seed << ","
+                 << p.iteration << ","
+                 << p.time << ","
+                 << p.evaluations << ","
+                 << p.bestMSE << "\n";
+        }
+    }
+    traj.close();
+
+    // Summary per configuration
+    ofstream sum((prefix + "_summary.csv").c_str());
+    sum << "plant,mode,threads,runs,reached,targetMSE,"
+        << "medianTimeToTarget,ciLow,ciHigh,"
+        << "medianEvalsToTarget,medianEvalsPerSec,medianFinalMSE,speedupAtTarget\n";
+
+    double serialMedian = INF;
+
+    for (const BenchConfig& c : configs) {
+        vector<double> ttt, ett, eps, finals;
+        int reached = 0;
+
+        for (const BenchRun& r : runs) {
+            if (r.backend != c.backend || r.threads != c.threads || r.trace.empty()) continue;
+
+            const TracePoint* hit = firstReaching(r, target);
+            if (hit != nullptr) {
+                reached++;
+                ttt.push_back(hit->time);
+                ett.push_back((double)hit->evaluations);
+            } else {
+                ttt.push_back(INF);
+                ett.push_back(INF);
+            }
+
+            const TracePoint& last = r.trace.back();
+            eps.push_back(last.evaluations / r.totalTime);
+            finals.push_back(last.bestMSE);
+        }
+
+        double med = median(ttt);
+        double lo, hi;
+        medianCI(ttt, lo, hi);
+        if (c.backend == BACKEND_SEQUENTIAL) serialMedian = med;
+
+        double speedup = (isinf(med) || isinf(serialMedian)) ? 0.0 : serialMedian / med;
+
+        sum << plantIndex << ","
+            << backendName(c.backend) << ","
+            << c.threads << ","
+            << ttt.size() << ","
+            << reached << ","
+            << target << ","
+            << med << ","
+            << lo << ","
+            << hi << ","
+            << median(ett) << ","
+            << median(eps) << ","
+            << median(finals) << ","
+            << speedup << "\n";
+
+        cout << backendName(c.backend) << " threads=" << c.threads
+             << ": reached " << reached << "/" << ttt.size()
+             << ", median time-to-target " << med
+             << " s [" << lo << ", " << hi << "]"
+             << ", speedup " << speedup << "\n";
+    }
+    sum.close();
+
+    cout << "Target MSE      : " << target << "\n";
+    cout << "Results saved to: " << prefix << "_summary.csv, "
+         << prefix << "_trajectories.csv\n";
+
+    return 0;
+}
@@ -1,51 +1,44 @@
 #include <iostream>
 #include <vector>
+#include <string>
 #include <cstdlib>
 #include <omp.h>
 
 #include "bco_parallel.h"
+#include "plants.h"
 #include "pid_simulator.h"
+#include "trace.h"
 #include "utils.h"
 
 using namespace std;
 
 
-// Plant definitions (same as serial version)
-void getG1(vector<double>& num, vector<double>& den)
-{
-    num = {1.0};
-    den = {1.0, 1.0};
-}
-
-void getG2(vector<double>& num, vector<double>& den)
-{
-    num = {5.0};
-    den = {1.0, 2.0, 5.0};
-}
-
-void getG3(vector<double>& num, vector<double>& den)
-{
-    num = {10.0};
-    den = {1.0, 3.0, 12.0, 10.0};
-}
-
-
-// Usage: ./bco_parallel <threads> <plantIndex{1,2,3}> [H|C]
+// Usage: ./bco_parallel <threads> <plantIndex{1,2,3}> [H|C] [none|compact|scatter] [nominal|mean|worst] [traceFile] [decimation]
 // H = human-readable output
 // C = CSV output
+// 4th argument = thread pinning policy (default none)
+// 5th argument = fitness: nominal step MSE (default), or mean / worst-case
+//                MSE over the robust scenario batch (+-20% on den)
+// 6th argument = binary trace file of the best controller's step response
+//                (y, u, error; see trace.h)
+// 7th argument = trace decimation (default 10: every 10th step)
 int main(int argc, char* argv[])
 {
     // Argument Parsing & Validation
-    if (argc != 3 && argc != 4) {
+    if (argc < 3 || argc > 8) {
         cout << "Usage: " << argv[0]
-             << " <threads> <plantIndex{1,2,3}> [H|C]"
+             << " <threads> <plantIndex{1,2,3}> [H|C] [none|compact|scatter] [nominal|mean|worst] [traceFile] [decimation]"
              << endl;
         return 1;
     }
 
     int threads = atoi(argv[1]);
     int plantIndex = atoi(argv[2]);
-    char mode = (argc == 4 ? argv[3][0] : 'H');  // default = H
+    char mode = (argc >= 4 ? argv[3][0] : 'H');  // default = H
+    AffinityPolicy affinity = AFFINITY_NONE;
+    string fitness = (argc >= 6 ? argv[5] : "nominal");
+    const char* traceFile = (argc >= 7 ? argv[6] : nullptr);
+    int decimation = (argc >= 8 ? atoi(argv[7]) : 10);
 
     if (threads <= 0) {
         cout << "Error: thread count must be > 0\n";
@@ -59,14 +52,24 @@ int main(int argc, char* argv[])
         cout << "Error: Output mode must be H or C\n";
         return 1;
     }
+    if (argc >= 5 && !parseAffinity(argv[4], affinity)) {
+        cout << "Error: affinity must be none, compact or scatter\n";
+        return 1;
+    }
+    if (fitness != "nominal" && fitness != "mean" && fitness != "worst") {
+        cout << "Error: fitness must be nominal, mean or worst\n";
+        return 1;
+    }
+    if (decimation <= 0) {
+        cout << "Error: decimation must be > 0\n";
+        return 1;
+    }
 
     omp_set_num_threads(threads);
 
     // Load plant
     vector<double> num, den;
-    if (plantIndex == 1) getG1(num, den);
-    else if (plantIndex == 2) getG2(num, den);
-    else getG3(num, den);
+    getPlant(plantIndex, num, den);
 
     // BCO Settings
     BCOSettings settings;
@@ -80,6 +83,28 @@ int main(int argc, char* argv[])
 
     settings.dt = 0.001;
     settings.simTime = 40.0;
+    settings.affinity = affinity;
+
+    // Robust fitness over plant uncertainty, references and disturbances
+    ScenarioBatch scenarios;
+    if (fitness != "nominal") {
+        buildScenarioBatch(num.data(), num.size(), den.data(), den.size(),
+                           0.2, settings.simTime, scenarios);
+        settings.fitnessMode = FITNESS_SCENARIOS;
+        settings.scenarios = &scenarios;
+        settings.aggregate = (fitness == "worst" ? AGGREGATE_WORST : AGGREGATE_MEAN);
+    }
+
+    // Step response of the winner, written straight into the mapped file
+    TraceBuffer trace;
+    if (traceFile != nullptr) {
+        int samples = traceSamples(settings.dt, settings.simTime, decimation);
+        if (!mapTraceBuffer(trace, samples, decimation, traceFile)) {
+            cout << "Error: cannot create trace file " << traceFile << "\n";
+            return 1;
+        }
+        settings.bestTrace = &trace;
+    }
 
     PIDParams bestPID;
     double bestMSE = 1e9;
@@ -103,17 +128,30 @@ int main(int argc, char* argv[])
     double t1 = omp_get_wtime();
     double elapsed = t1 - t0;
 
+    if (traceFile != nullptr) unmapTraceBuffer(trace);
+
     // Output Results
     if (mode == 'H') {
         cout << "Threads         : " << threads << "\n";
         cout << "Plant           : G" << plantIndex << "\n";
+        cout << "Affinity        : " << affinityName(affinity)
+             << " (" << socketCount() << " socket(s))\n";
+        cout << "Fitness         : " << fitness;
+        if (fitness != "nominal") cout << " over " << scenarios.count << " scenarios";
+        cout << "\n";
+        cout << "Best MSE        : " << bestMSE << "\n";
         cout << "Execution Time  : " << elapsed << " seconds\n";
+        if (traceFile != nullptr) {
+            cout << "Trace           : " << traceFile
+                 << " (" << trace.count << " samples)\n";
+        }
     }
     else { // CSV mode
-        // threads, plantIndex, time
+        // threads, plantIndex, time, affinity
         cout << threads << ","
              << plantIndex << ","
-             << elapsed << endl;
+             << elapsed << ","
+             << affinityName(affinity) << endl;
     }
 
     return 0;
@@ -0,0 +1,258 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include <omp.h>
+
+#include "bco.h"
+#include "bee_population.h"
+#include "pid_simulator.h"
+#include "plants.h"
+
+using namespace std;
+
+
+// Search box and BCO settings of the recorded runs
+// (main_serial / main_parallel, with a smaller colony to keep this quick)
+const double GAIN_MIN = -10.0;
+const double GAIN_MAX = 10.0;
+
+const double DT = 0.001;
+const double SIM_TIME = 40.0;
+
+const int RUN_BEES = 30;
+const int RUN_LIMIT = 30;
+
+
+// One greedy-selection decision taken by runBCO: current bee vs. its candidate
+struct DecisionPair {
+    int iteration;
+    PIDParams current;
+    PIDParams candidate;
+    double currentMSE;     // double-precision fitness seen by the run
+    double candidateMSE;
+};
+
+// relative MSE gap of a decision (small = close call)
+double relativeGap(const DecisionPair& d)
+{
+    return fabs(d.candidateMSE - d.currentMSE) / d.currentMSE;
+}
+
+const char* precisionName(Precision p)
+{
+    if (p == PRECISION_FLOAT) return "float";
+    if (p == PRECISION_MIXED) return "mixed";
+    return "double";
+}
+
+// BCOSettings::selection hook: records every active decision between two
+// stable, distinct gain sets (a converged partner can yield candidate ==
+// current, and two penalized gains always tie; neither is a real decision)
+void recordDecisions(int iteration, const BeePopulation& pop, int begin, int end, void* user)
+{
+    vector<DecisionPair>* out = (vector<DecisionPair>*)user;
+    for (int i = begin; i < end; i++) {
+        if (!pop.active[i]) continue;
+        if (pop.fitness[i] >= 1e9 || pop.candFitness[i] >= 1e9) continue;
+        if (pop.candKp[i] == pop.Kp[i] && pop.candKi[i] == pop.Ki[i] &&
+            pop.candKd[i] == pop.Kd[i]) continue;
+
+        DecisionPair d;
+        d.iteration = iteration;
+        d.current.Kp = pop.Kp[i];
+        d.current.Ki = pop.Ki[i];
+        d.current.Kd = pop.Kd[i];
+        d.candidate.Kp = pop.candKp[i];
+        d.candidate.Ki = pop.candKi[i];
+        d.candidate.Kd = pop.candKd[i];
+        d.currentMSE = pop.fitness[i];
+        d.candidateMSE = pop.candFitness[i];
+        out->push_back(d);
+    }
+}
+
+// up to `samples` decisions drawn at random from `from`
+void sampleDecisions(vector<DecisionPair> from, int samples, mt19937& rng,
+                     vector<DecisionPair>& out)
+{
+    shuffle(from.begin(), from.end(), rng);
+    if ((int)from.size() > samples) from.resize(samples);
+    out = from;
+}
+
+// the `samples` decisions with the smallest relative gap
+void closestDecisions(vector<DecisionPair> from, int samples, vector<DecisionPair>& out)
+{
+    sort(from.begin(), from.end(), [](const DecisionPair& a, const DecisionPair& b) {
+        return relativeGap(a) < relativeGap(b);
+    });
+    if ((int)from.size() > samples) from.resize(samples);
+    out = from;
+}
+
+double medianGap(const vector<DecisionPair>& pairs)
+{
+    if (pairs.empty()) return 0.0;
+    vector<double> g;
+    for (const DecisionPair& d : pairs) g.push_back(relativeGap(d));
+    sort(g.begin(), g.end());
+    return g[g.size() / 2];
+}
+
+
+// Usage: ./bco_precision [samples] [outFile] [maxIterations]
+// Runs runBCO on G1-G3, records its greedy-selection decisions, and
+// replays <samples> of them under the float and mixed kernels:
+//   early : decisions of the first 10% of iterations
+//   late  : decisions of the second half (converged partners)
+//   close : the decisions with the smallest relative MSE gap
+// Counts outcomes that differ from double and writes a CSV report.
+int main(int argc, char* argv[])
+{
+    if (argc > 4) {
+        cout << "Usage: " << argv[0] << " [samples] [outFile] [maxIterations]" << endl;
+        return 1;
+    }
+
+    int samples = (argc >= 2 ? atoi(argv[1]) : 200);
+    string outFile = (argc >= 3 ? argv[2] : "precision_report.csv");
+    int maxIterations = (argc >= 4 ? atoi(argv[3]) : 200);
+
+    if (samples <= 0) {
+        cout << "Error: samples must be > 0\n";
+        return 1;
+    }
+    if (maxIterations <= 0) {
+        cout << "Error: maxIterations must be > 0\n";
+        return 1;
+    }
+
+    ofstream out(outFile.c_str());
+    if (!out.is_open()) {
+        cout << "Error: cannot open " << outFile << "\n";
+        return 1;
+    }
+    out << "plant,pairs,precision,samples,medianRelGap,flips,flipRate,meanRelErr,maxRelErr,evalTime\n";
+
+    mt19937 rng(12345);
+
+    const Precision tested[] = {PRECISION_FLOAT, PRECISION_MIXED};
+    const char* pairSets[] = {"early", "late", "close"};
+
+    for (int plant = 1; plant <= 3; plant++) {
+        vector<double> num, den;
+        getPlant(plant, num, den);
+
+        // Record the decisions of one double-precision run
+        BCOSettings settings;
+        settings.numBees = RUN_BEES;
+        settings.maxIterations = maxIterations;
+        settings.limit = RUN_LIMIT;
+        settings.KpMin = GAIN_MIN;  settings.KpMax = GAIN_MAX;
+        settings.KiMin = GAIN_MIN;  settings.KiMax = GAIN_MAX;
+        settings.KdMin = GAIN_MIN;  settings.KdMax = GAIN_MAX;
+        settings.dt = DT;
+        settings.simTime = SIM_TIME;
+
+        vector<DecisionPair> decisions;
+        settings.selection = recordDecisions;
+        settings.selectionUser = &decisions;
+
+        PIDParams bestPID;
+        double bestMSE;
+        runBCO(num.data(), num.size(), den.data(), den.size(),
+               settings, bestPID, bestMSE, nullptr);
+
+        vector<DecisionPair> early, late;
+        for (const DecisionPair& d : decisions) {
+            if (d.iteration < maxIterations / 10) early.push_back(d);
+            else if (d.iteration >= maxIterations / 2) late.push_back(d);
+        }
+
+        cout << "G" << plant << ": " << decisions.size() << " decisions recorded, best MSE "
+             << bestMSE << "\n";
+
+        for (int set = 0; set < 3; set++) {
+            vector<DecisionPair> pairs;
+            if (set == 0) sampleDecisions(early, samples, rng, pairs);
+            else if (set == 1) sampleDecisions(late, samples, rng, pairs);
+            else closestDecisions(decisions, samples, pairs);
+
+            int n = (int)pairs.size();
+            if (n == 0) continue;
+            double gap = medianGap(pairs);
+
+            // Reference decisions in double
+            vector<double> refCur(n), refCand(n);
+            double t0 = omp_get_wtime();
+            for (int s = 0; s < n; s++) {
+                refCur[s]  = simulatePID(pairs[s].current, num.data(), num.size(),
+                                         den.data(), den.size(), DT, SIM_TIME).mse;
+                refCand[s] = simulatePID(pairs[s].candidate, num.data(), num.size(),
+                                         den.data(), den.size(), DT, SIM_TIME).mse;
+            }
+            double refTime = (omp_get_wtime() - t0) / (2.0 * n);
+
+            out << plant << "," << pairSets[set] << ",double,"
+                << n << "," << gap << ",0,0,0,0," << refTime << "\n";
+
+            for (Precision p : tested) {
+                int flips = 0;
+                int stable = 0;
+                double sumRel = 0.0;
+                double maxRel = 0.0;
+
+                t0 = omp_get_wtime();
+                for (int s = 0; s < n; s++) {
+                    double cur  = simulatePID(pairs[s].current, num.data(), num.size(),
+                                              den.data(), den.size(), DT, SIM_TIME, p).mse;
+                    double cand = simulatePID(pairs[s].candidate, num.data(), num.size(),
+                                              den.data(), den.size(), DT, SIM_TIME, p).mse;
+
+                    bool refAccept = refCand[s] < refCur[s];
+                    bool accept = cand < cur;
+                    if (accept != refAccept) flips++;
+
+                    // relative MSE error, stable candidates only
+                    if (refCand[s] < 1e9) {
+                        double rel = fabs(cand - refCand[s]) / refCand[s];
+                        sumRel += rel;
+                        if (rel > maxRel) maxRel = rel;
+                        stable++;
+                    }
+                }
+                double evalTime = (omp_get_wtime() - t0) / (2.0 * n);
+
+                double flipRate = (double)flips / n;
+                double meanRel = (stable > 0 ? sumRel / stable : 0.0);
+
+                out << plant << ","
+                    << pairSets[set] << ","
+                    << precisionName(p) << ","
+                    << n << ","
+                    << gap << ","
+                    << flips << ","
+                    << flipRate << ","
+                    << meanRel << ","
+                    << maxRel << ","
+                    << evalTime << "\n";
+
+                cout << "G" << plant << " " << pairSets[set] << " " << precisionName(p)
+                     << ": flips " << flips << "/" << n
+                     << " (median gap " << gap << ")"
+                     << ", mean rel. error " << meanRel
+                     << ", speedup vs double " << refTime / evalTime << "\n";
+            }
+        }
+    }
+
+    out.close();
+    cout << "Report saved to: " << outFile << "\n";
+
+    return 0;
+}
@@ -1,34 +1,12 @@
 #include <iostream>
 #include <vector>
 #include "bco.h"
+#include "plants.h"
 #include "utils.h"
 
 using namespace std;
 
 
-// Define the three plants
-// G1(s) = 1 / (s + 1)
-void getG1(vector<double>& num, vector<double>& den)
-{
-    num = {1.0};        // numerator
-    den = {1.0, 1.0};   // s + 1   (1*s + 1)
-}
-
-// G2(s) = 5 / (s^2 + 2s + 5)
-void getG2(vector<double>& num, vector<double>& den)
-{
-    num = {5.0};
-    den = {1.0, 2.0, 5.0}; // s^2 + 2s + 5
-}
-
-// G3(s) = 10 / ((s+1)(s^2 + 2s + 10))
-// expanded: 10 / (s^3 + 3s^2 + 12s + 10)
-void getG3(vector<double>& num, vector<double>& den)
-{
-    num = {10.0};
-    den = {1.0, 3.0, 12.0, 10.0};
-}
-
 int main()
 {
     initRandom(12345);
@@ -44,9 +22,8 @@ int main()
     cout << "Enter choice: ";
     cin >> choice;
 
-    if (choice == 1) getG1(num, den);
-    else if (choice == 2) getG2(num, den);
-    else getG3(num, den);
+    if (choice < 1 || choice > 3) choice = 3;
+    getPlant(choice, num, den);
 
     // BCO Settings
     BCOSettings settings;
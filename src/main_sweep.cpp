@@ -0,0 +1,313 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <omp.h>
+
+#include "bco_parallel.h"
+#include "plants.h"
+#include "utils.h"
+
+using namespace std;
+
+
+// One point of the sweep design
+struct SweepConfig {
+    int id;
+    int numBees;
+    int limit;
+    int maxIterations;
+    int seed;
+};
+
+// Result of one configuration
+struct SweepResult {
+    double time;
+    double bestMSE;
+    PIDParams best;
+    int threads;
+};
+
+
+// Default grid values (override with a design file)
+const int GRID_BEES[]      = {25, 50, 100, 200};
+const int GRID_LIMITS[]    = {10, 30, 60};
+const int GRID_ITERATIONS[] = {100, 250, 500};
+const int GRID_SEEDS[]     = {12345, 23456, 34567};
+
+// Default ranges for the random design
+const int RAND_BEES_MIN = 20,  RAND_BEES_MAX = 200;
+const int RAND_LIMIT_MIN = 5,  RAND_LIMIT_MAX = 100;
+const int RAND_ITER_MIN = 100, RAND_ITER_MAX = 1000;
+
+
+// Sweep design: value lists for G, [min, max] ranges for R
+struct SweepDesign {
+    vector<int> bees, limits, iterations, seeds;
+    int beesRange[2], limitRange[2], iterationsRange[2];
+    int designSeed;   // seed of the random design
+};
+
+void defaultDesign(SweepDesign& d)
+{
+    d.bees.assign(begin(GRID_BEES), end(GRID_BEES));
+    d.limits.assign(begin(GRID_LIMITS), end(GRID_LIMITS));
+    d.iterations.assign(begin(GRID_ITERATIONS), end(GRID_ITERATIONS));
+    d.seeds.assign(begin(GRID_SEEDS), end(GRID_SEEDS));
+    d.beesRange[0] = RAND_BEES_MIN;       d.beesRange[1] = RAND_BEES_MAX;
+    d.limitRange[0] = RAND_LIMIT_MIN;     d.limitRange[1] = RAND_LIMIT_MAX;
+    d.iterationsRange[0] = RAND_ITER_MIN; d.iterationsRange[1] = RAND_ITER_MAX;
+    d.designSeed = 2024;
+}
+
+// "25,50,100" -> {25, 50, 100}; false on empty lists or entries < minValue
+bool parseIntList(const string& text, vector<int>& out, int minValue = 1)
+{
+    out.clear();
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        int v = atoi(item.c_str());
+        if (v < minValue) return false;
+        out.push_back(v);
+    }
+    return !out.empty();
+}
+
+bool parseRange(const string& text, int range[2], int minValue = 1)
+{
+    vector<int> v;
+    if (!parseIntList(text, v, minValue) || v.size() != 2 || v[0] > v[1]) return false;
+    range[0] = v[0];
+    range[1] = v[1];
+    return true;
+}
+
+// Reads `key = value` lines (# starts a comment) over the defaults:
+//   bees, limit, iterations, seeds           comma lists (G design, bees >= 2)
+//   bees_range, limit_range, iterations_range  min,max (R design)
+//   design_seed                              seed of the R design
+// Returns false and prints the offending line on error.
+bool readDesignFile(const string& path, SweepDesign& d)
+{
+    ifstream in(path.c_str());
+    if (!in.is_open()) {
+        cout << "Error: cannot open design file " << path << "\n";
+        return false;
+    }
+
+    string line;
+    int lineNo = 0;
+    while (getline(in, line)) {
+        lineNo++;
+        size_t hash = line.find('#');
+        if (hash != string::npos) line.erase(hash);
+
+        size_t eq = line.find('=');
+        string key = line.substr(0, eq);
+        key.erase(remove(key.begin(), key.end(), ' '), key.end());
+        if (key.empty() && eq == string::npos) continue;   // blank line
+
+        string value = (eq == string::npos ? "" : line.substr(eq + 1));
+        value.erase(remove(value.begin(), value.end(), ' '), value.end());
+
+        bool ok;
+        // partner draws need at least 2 bees
+        if (key == "bees")                  ok = parseIntList(value, d.bees, 2);
+        else if (key == "limit")            ok = parseIntList(value, d.limits);
+        else if (key == "iterations")       ok = parseIntList(value, d.iterations);
+        else if (key == "seeds")            ok = parseIntList(value, d.seeds);
+        else if (key == "bees_range")       ok = parseRange(value, d.beesRange, 2);
+        else if (key == "limit_range")      ok = parseRange(value, d.limitRange);
+        else if (key == "iterations_range") ok = parseRange(value, d.iterationsRange);
+        else if (key == "design_seed") {
+            d.designSeed = atoi(value.c_str());
+            ok = d.designSeed > 0;
+        }
+        else ok = false;
+
+        if (!ok) {
+            cout << "Error: " << path << ":" << lineNo << ": bad entry '" << line << "'\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void buildGrid(const SweepDesign& d, vector<SweepConfig>& configs)
+{
+    for (int b : d.bees)
+        for (int l : d.limits)
+            for (int it : d.iterations)
+                for (int s : d.seeds) {
+                    SweepConfig c;
+                    c.id = (int)configs.size();
+                    c.numBees = b;
+                    c.limit = l;
+                    c.maxIterations = it;
+                    c.seed = s;
+                    configs.push_back(c);
+                }
+}
+
+void buildRandom(const SweepDesign& d, vector<SweepConfig>& configs, int samples)
+{
+    initRandom(d.designSeed);   // design seed, independent of the run seeds
+    for (int i = 0; i < samples; i++) {
+        SweepConfig c;
+        c.id = i;
+        c.numBees = randomInt(d.beesRange[0], d.beesRange[1]);
+        c.limit = randomInt(d.limitRange[0], d.limitRange[1]);
+        c.maxIterations = randomInt(d.iterationsRange[0], d.iterationsRange[1]);
+        c.seed = randomInt(1, 1000000);
+        configs.push_back(c);
+    }
+}
+
+
+// Usage: ./bco_sweep <threads> <plantIndex{1,2,3}> <G|R> [concurrent] [samples] [outFile] [designFile]
+// G = full grid design, R = random design with <samples> points
+// concurrent = configurations in flight at once; the remaining threads
+//              are given to each colony (threads / concurrent per config)
+// designFile = value lists / ranges replacing the defaults above
+//              (see readDesignFile and sweep_design.txt)
+int main(int argc, char* argv[])
+{
+    // Argument Parsing & Validation
+    if (argc < 4 || argc > 8) {
+        cout << "Usage: " << argv[0]
+             << " <threads> <plantIndex{1,2,3}> <G|R> [concurrent] [samples] [outFile] [designFile]"
+             << endl;
+        return 1;
+    }
+
+    int threads = atoi(argv[1]);
+    int plantIndex = atoi(argv[2]);
+    char design = argv[3][0];
+    int concurrent = (argc >= 5 ? atoi(argv[4]) : threads);
+    int samples = (argc >= 6 ? atoi(argv[5]) : 32);
+    string outFile = (argc >= 7 ? argv[6] : "sweep_results.csv");
+
+    if (threads <= 0) {
+        cout << "Error: thread count must be > 0\n";
+        return 1;
+    }
+    if (plantIndex < 1 || plantIndex > 3) {
+        cout << "Error: plant index must be 1, 2, or 3\n";
+        return 1;
+    }
+    if (design != 'G' && design != 'R') {
+        cout << "Error: design must be G or R\n";
+        return 1;
+    }
+    if (concurrent <= 0 || concurrent > threads) {
+        cout << "Error: concurrent must be in [1, threads]\n";
+        return 1;
+    }
+    if (samples <= 0) {
+        cout << "Error: samples must be > 0\n";
+        return 1;
+    }
+
+    vector<double> num, den;
+    getPlant(plantIndex, num, den);
+
+    SweepDesign sweep;
+    defaultDesign(sweep);
+    if (argc >= 8 && !readDesignFile(argv[7], sweep)) return 1;
+
+    vector<SweepConfig> configs;
+    if (design == 'G') buildGrid(sweep, configs);
+    else buildRandom(sweep, configs, samples);
+
+    // Longest jobs first so the dynamic schedule does not end on a straggler
+    vector<int> order(configs.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = (int)i;
+    sort(order.begin(), order.end(), [&](int a, int b) {
+        return (long long)configs[a].numBees * configs[a].maxIterations >
+               (long long)configs[b].numBees * configs[b].maxIterations;
+    });
+
+    // Two levels: configs on the outer team, colony loops on the inner team
+    int inner = max(1, threads / concurrent);
+    omp_set_max_active_levels(2);
+
+    vector<SweepResult> results(configs.size());
+    double t0 = omp_get_wtime();
+
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(concurrent)
+    for (int j = 0; j < (int)order.size(); j++) {
+        const SweepConfig& c = configs[order[j]];
+
+        BCOSettings settings;
+        settings.numBees = c.numBees;
+        settings.maxIterations = c.maxIterations;
+        settings.limit = c.limit;
+
+        settings.KpMin = -10.0;  settings.KpMax = 10.0;
+        settings.KiMin = -10.0;  settings.KiMax = 10.0;
+        settings.KdMin = -10.0;  settings.KdMax = 10.0;
+
+        settings.dt = 0.001;
+        settings.simTime = 40.0;
+        settings.seed = c.seed;
+
+        // applies to the nested regions started by this thread only
+        omp_set_num_threads(inner);
+
+        SweepResult& r = results[c.id];
+        double s0 = omp_get_wtime();
+        runBCOParallel(num.data(), num.size(),
+                       den.data(), den.size(),
+                       settings,
+                       r.best,
+                       r.bestMSE,
+                       nullptr);
+        r.time = omp_get_wtime() - s0;
+        r.threads = inner;
+
+        #pragma omp critical
+        cout << "Config " << c.id << " done: bees=" << c.numBees
+             << " limit=" << c.limit << " iters=" << c.maxIterations
+             << " seed=" << c.seed << " MSE=" << r.bestMSE
+             << " time=" << r.time << "s\n";
+    }
+
+    double elapsed = omp_get_wtime() - t0;
+
+    // Columnar results, one row per configuration
+    ofstream out(outFile.c_str());
+    if (!out.is_open()) {
+        cout << "Error: cannot open " << outFile << "\n";
+        return 1;
+    }
+    out << "config,plant,numBees,limit,maxIterations,seed,threads,time,bestMSE,Kp,Ki,Kd\n";
+    for (size_t i = 0; i < configs.size(); i++) {
+        const SweepConfig& c = configs[i];
+        const SweepResult& r = results[i];
+        out << c.id << ","
+            << plantIndex << ","
+            << c.numBees << ","
+            << c.limit << ","
+            << c.maxIterations << ","
+            << c.seed << ","
+            << r.threads << ","
+            << r.time << ","
+            << r.bestMSE << ","
+            << r.best.Kp << ","
+            << r.best.Ki << ","
+            << r.best.Kd << "\n";
+    }
+    out.close();
+
+    cout << "Configurations  : " << configs.size() << "\n";
+    cout << "Concurrent      : " << concurrent << " x " << inner << " threads\n";
+    cout << "Total Time      : " << elapsed << " seconds\n";
+    cout << "Results saved to: " << outFile << "\n";
+
+    return 0;
+}
@@ -1,82 +1,116 @@
 #include "pid_simulator.h"
+#include "trace.h"
 #include <cmath>   // for fabs()
 #include <vector>
 
-// Simulates a PID controller on a linear plant defined by (num/den)
-// num, den = plant coefficients
-// dt = simulation step
-// simTime = total simulation time
-PIDResult simulatePID(const PIDParams& params, const double* num, int numSize,
-                      const double* den, int denSize, double dt, double simTime)
+// Trace policies of the kernel. NoTrace compiles to nothing, so the
+// optimizer's evaluations carry no tracing cost.
+struct NoTrace {
+    template <typename Real>
+    void record(Real, Real, Real) {}
+};
+
+// Stores every decimation-th step into a TraceBuffer (stops when full)
+struct BufferTrace {
+    TraceBuffer* trace;
+    int countdown;   // steps until the next sample
+
+    template <typename Real>
+    void record(Real y, Real u, Real error)
+    {
+        if (--countdown > 0) return;
+        countdown = trace->decimation;
+
+        int k = trace->count;
+        if (k >= trace->capacity) return;
+        trace->y[k] = (double)y;
+        trace->u[k] = (double)u;
+        trace->error[k] = (double)error;
+        trace->count = k + 1;
+    }
+};
+
+// Simulation kernel shared by all precision modes.
+// Real   = type of the controller/plant state
+// Acc    = type of the MSE accumulator
+// Tracer = NoTrace or BufferTrace
+template <typename Real, typename Acc, typename Tracer>
+static PIDResult simulatePIDKernel(const PIDParams& params, const double* num,
+                                   const double* den, int denSize,
+                                   double dtIn, double simTime, Tracer& tracer)
 {
-    double Kp = params.Kp;
-    double Ki = params.Ki;
-    double Kd = params.Kd;
+    Real Kp = (Real)params.Kp;
+    Real Ki = (Real)params.Ki;
+    Real Kd = (Real)params.Kd;
+    Real dt = (Real)dtIn;
 
     // Simulation variables
-    double y  = 0.0;  // plant output
-    double x1 = 0.0;  // internal plant state
-    double x2 = 0.0;  // second state if needed
-    double x3 = 0.0;  // third state if needed
+    Real y  = 0;  // plant output
+    Real x1 = 0;  // internal plant state
+    Real x2 = 0;  // second state if needed
+    Real x3 = 0;  // third state if needed
 
-    double integral   = 0.0;
-    double prevError  = 0.0;
+    Real integral   = 0;
+    Real prevError  = 0;
 
-    double mse   = 0.0;
-    int steps    = (int)(simTime / dt);
-    double reference = 1.0;
+    Acc mse      = 0;
+    bool unstable = false;
+    int steps    = (int)(simTime / dtIn);
+    Real reference = 1;
 
     // safety thresholds
-    const double MAX_VAL = 1e6;
+    const Real MAX_VAL = (Real)1e6;
 
     for (int i = 0; i < steps; i++) {
 
-        double error = reference - y;
+        Real error = reference - y;
 
         // If error already non-finite, bail out
         if (!std::isfinite(error)) {
-            mse = 1e9;
+            unstable = true;
             break;
         }
 
         // PID terms
         integral += error * dt;
-        double derivative = (error - prevError) / dt;
-        double u = Kp * error + Ki * integral + Kd * derivative;
+        Real derivative = (error - prevError) / dt;
+        Real u = Kp * error + Ki * integral + Kd * derivative;
 
         // Check controller output
         if (!std::isfinite(u) || std::fabs(u) > MAX_VAL ||
             !std::isfinite(integral) || std::fabs(integral) > MAX_VAL) {
-            mse = 1e9;
+            unstable = true;
             break;
         }
 
+        tracer.record(y, u, error);   // signals at t = i * dt
+
         // plant simulation 
         if (denSize == 2) {
             // First order: y' = -a*y + b*u
-            double a = den[1];
-            double b = num[0];
+            Real a = (Real)den[1];
+            Real b = (Real)num[0];
             y += dt * (-a * y + b * u);
         }
         else if (denSize == 3) {
             // Second order: y'' + a1*y' + a0*y = b*u
-            double a1 = den[1];
-            double a0 = den[2];
-            double b  = num[0];
+            Real a1 = (Real)den[1];
+            Real a0 = (Real)den[2];
+            Real b  = (Real)num[0];
 
-            double y_ddot = b * u - a1 * x2 - a0 * x1;
+            Real y_ddot = b * u - a1 * x2 - a0 * x1;
             x2 += dt * y_ddot;
             x1 += dt * x2;
             y  = x1;
         }
         else if (denSize == 4) {
             // Third order: y''' + a2*y'' + a1*y' + a0*y = b*u
-            double a2 = den[1];
-            double a1 = den[2];
-            double a0 = den[3];
-            double b  = num[0];
+            Real a2 = (Real)den[1];
+            Real a1 = (Real)den[2];
+            Real a0 = (Real)den[3];
+            Real b  = (Real)num[0];
 
-            double y_dddot = b * u - a2 * x3 - a1 * x2 - a0 * x1;
+            Real y_dddot = b * u - a2 * x3 - a1 * x2 - a0 * x1;
             x3 += dt * y_dddot;
             x2 += dt * x3;
             x1 += dt * x2;
@@ -85,21 +119,64 @@ PIDResult simulatePID(const PIDParams& params, const double* num, int numSize,
 
         // Check plant output
         if (!std::isfinite(y) || std::fabs(y) > MAX_VAL) {
-            mse = 1e9;
+            unstable = true;
             break;
         }
 
-        mse += error * error;
+        mse += (Acc)error * (Acc)error;
         prevError = error;
     }
 
-    if (mse < 1e9 && steps > 0) {
-        mse /= steps;   // normal case
-    }
-    // else mse == 1e9 which is unstable candidate penalized
-
     PIDResult result;
-    result.mse = mse;
-    result.finalValue = y;
+    if (unstable) {
+        result.mse = 1e9;   // unstable candidate penalized
+    } else {
+        result.mse = (double)mse;
+        if (result.mse < 1e9 && steps > 0) {
+            result.mse /= steps;   // normal case
+        }
+    }
+    result.finalValue = (double)y;
     return result;
-}
\ No newline at end of file
+}
+
+
+// Simulates a PID controller on a linear plant defined by (num/den)
+// num, den = plant coefficients
+// dt = simulation step
+// simTime = total simulation time
+PIDResult simulatePID(const PIDParams& params, const double* num, int numSize,
+                      const double* den, int denSize, double dt, double simTime)
+{
+    (void)numSize;
+    NoTrace tracer;
+    return simulatePIDKernel<double, double>(params, num, den, denSize, dt, simTime, tracer);
+}
+
+PIDResult simulatePID(const PIDParams& params, const double* num, int numSize,
+                      const double* den, int denSize, double dt, double simTime,
+                      Precision precision)
+{
+    (void)numSize;
+    NoTrace tracer;
+    if (precision == PRECISION_FLOAT)
+        return simulatePIDKernel<float, float>(params, num, den, denSize, dt, simTime, tracer);
+    if (precision == PRECISION_MIXED)
+        return simulatePIDKernel<float, double>(params, num, den, denSize, dt, simTime, tracer);
+    return simulatePIDKernel<double, double>(params, num, den, denSize, dt, simTime, tracer);
+}
+
+PIDResult simulatePID(const PIDParams& params, const double* num, int numSize,
+                      const double* den, int denSize, double dt, double simTime,
+                      TraceBuffer& trace)
+{
+    (void)numSize;
+    trace.count = 0;
+    trace.sampleTime = dt * trace.decimation;
+    trace.params = params;
+
+    BufferTrace tracer;
+    tracer.trace = &trace;
+    tracer.countdown = 1;   // first sample at t = 0
+    return simulatePIDKernel<double, double>(params, num, den, denSize, dt, simTime, tracer);
+}
@@ -0,0 +1,35 @@
+#include "plants.h"
+
+using namespace std;
+
+
+// G1(s) = 1 / (s + 1)
+void getG1(vector<double>& num, vector<double>& den)
+{
+    num = {1.0};        // numerator
+    den = {1.0, 1.0};   // s + 1   (1*s + 1)
+}
+
+// G2(s) = 5 / (s^2 + 2s + 5)
+void getG2(vector<double>& num, vector<double>& den)
+{
+    num = {5.0};
+    den = {1.0, 2.0, 5.0}; // s^2 + 2s + 5
+}
+
+// G3(s) = 10 / ((s+1)(s^2 + 2s + 10))
+// expanded: 10 / (s^3 + 3s^2 + 12s + 10)
+void getG3(vector<double>& num, vector<double>& den)
+{
+    num = {10.0};
+    den = {1.0, 3.0, 12.0, 10.0};
+}
+
+bool getPlant(int plantIndex, vector<double>& num, vector<double>& den)
+{
+    if (plantIndex == 1) getG1(num, den);
+    else if (plantIndex == 2) getG2(num, den);
+    else if (plantIndex == 3) getG3(num, den);
+    else return false;
+    return true;
+}
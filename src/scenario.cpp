@@ -0,0 +1,261 @@
+#include "scenario.h"
+#include <cmath>
+#include <stdexcept>   // invalid_argument
+
+using namespace std;
+
+
+// penalty for an unstable scenario (same as simulatePID)
+const double UNSTABLE_MSE = 1e9;
+
+// safety threshold (same as simulatePID)
+const double MAX_VAL = 1e6;
+
+// steps between early-exit checks
+const int EARLY_EXIT_INTERVAL = 500;
+
+
+void initScenarioBatch(ScenarioBatch& batch, int order)
+{
+    batch.count = 0;
+    batch.order = order;
+}
+
+
+bool addScenario(ScenarioBatch& batch, const double* num, const double* den,
+                 double refAmplitude, double rampTime,
+                 double loadTime, double loadSize)
+{
+    if (batch.count >= MAX_SCENARIOS) return false;
+    if (batch.order < 1 || batch.order > MAX_ORDER) return false;
+
+    int s = batch.count++;
+    batch.b[s]  = num[0];
+    batch.c1[s] = den[1];
+    batch.c2[s] = (batch.order >= 2 ? den[2] : 0.0);
+    batch.c3[s] = (batch.order >= 3 ? den[3] : 0.0);
+
+    batch.refAmplitude[s] = refAmplitude;
+    batch.rampTime[s] = rampTime;
+    batch.loadTime[s] = loadTime;
+    batch.loadSize[s] = loadSize;
+    return true;
+}
+
+
+void buildScenarioBatch(const double* num, int numSize,
+                        const double* den, int denSize,
+                        double uncertainty, double simTime,
+                        ScenarioBatch& batch)
+{
+    (void)numSize;
+    int order = denSize - 1;
+    if (order < 1 || order > MAX_ORDER) {
+        throw invalid_argument("buildScenarioBatch: plant order must be 1 to 3");
+    }
+    initScenarioBatch(batch, order);
+
+    // plant variants: nominal, then all 2^order corners
+    double variants[1 + (1 << MAX_ORDER)][MAX_ORDER + 1];
+    int numVariants = 0;
+
+    for (int j = 0; j < denSize; j++) variants[0][j] = den[j];
+    numVariants = 1;
+
+    for (int mask = 0; mask < (1 << order); mask++) {
+        variants[numVariants][0] = den[0];
+        for (int j = 1; j < denSize; j++) {
+            double scale = (mask & (1 << (j - 1))) ? 1.0 + uncertainty : 1.0 - uncertainty;
+            variants[numVariants][j] = den[j] * scale;
+        }
+        numVariants++;
+    }
+
+    // reference profiles: {amplitude, ramp time}
+    const double refs[3][2] = {
+        {1.0, 0.0},
+        {0.5, 0.0},
+        {1.0, simTime / 10.0}
+    };
+
+    // disturbances: {time, size}
+    const double loads[2][2] = {
+        {simTime, 0.0},
+        {simTime / 2.0, 0.5}
+    };
+
+    for (int v = 0; v < numVariants; v++)
+        for (int r = 0; r < 3; r++)
+            for (int l = 0; l < 2; l++)
+                addScenario(batch, num, variants[v],
+                            refs[r][0], refs[r][1],
+                            loads[l][0], loads[l][1]);
+}
+
+
+// aggregate of the per-scenario MSE, with partial sums over `steps`
+template <typename Acc>
+static double aggregateMSE(const ScenarioBatch& batch, const Acc* sum,
+                           const int* dead, int steps, ScenarioAggregate aggregate)
+{
+    double total = 0.0;
+    double worst = 0.0;
+
+    for (int s = 0; s < batch.count; s++) {
+        double amp2 = batch.refAmplitude[s] * batch.refAmplitude[s];
+        double mse = dead[s] ? UNSTABLE_MSE : (double)sum[s] / (steps * amp2);
+        total += mse;
+        if (mse > worst) worst = mse;
+    }
+
+    if (aggregate == AGGREGATE_WORST) return worst;
+    return total / batch.count;
+}
+
+
+// Lockstep kernel for one plant order. Lane state lives in fixed arrays;
+// dead lanes are zeroed and excluded so the SIMD loop never branches.
+// Real = type of the lane state and scenario data (float packs twice as
+// many lanes per vector), Acc = type of the squared-error sums, as in
+// simulatePIDKernel.
+template <int ORDER, typename Real, typename Acc>
+static double simulateBatchKernel(const PIDParams& params, const ScenarioBatch& batch,
+                                  double dtIn, double simTime,
+                                  ScenarioAggregate aggregate, double cutoff)
+{
+    const int n = batch.count;
+    const Real Kp = (Real)params.Kp;
+    const Real Ki = (Real)params.Ki;
+    const Real Kd = (Real)params.Kd;
+    const Real dt = (Real)dtIn;
+    const Real maxVal = (Real)MAX_VAL;
+
+    alignas(64) Real y[MAX_SCENARIOS];
+    alignas(64) Real x2[MAX_SCENARIOS];
+    alignas(64) Real x3[MAX_SCENARIOS];
+    alignas(64) Real integral[MAX_SCENARIOS];
+    alignas(64) Real prevError[MAX_SCENARIOS];
+    alignas(64) Acc sum[MAX_SCENARIOS];
+    alignas(64) int dead[MAX_SCENARIOS];
+
+    // scenario data in the kernel's precision
+    alignas(64) Real b[MAX_SCENARIOS];
+    alignas(64) Real c1[MAX_SCENARIOS];
+    alignas(64) Real c2[MAX_SCENARIOS];
+    alignas(64) Real c3[MAX_SCENARIOS];
+    alignas(64) Real amp[MAX_SCENARIOS];
+    alignas(64) Real ramp[MAX_SCENARIOS];       // 1 for steps (no division by 0)
+    alignas(64) Real stepShape[MAX_SCENARIOS];  // 1 for steps, 0 for ramps
+    alignas(64) Real loadTime[MAX_SCENARIOS];
+    alignas(64) Real loadSize[MAX_SCENARIOS];
+
+    for (int s = 0; s < n; s++) {
+        y[s] = x2[s] = x3[s] = 0;
+        integral[s] = prevError[s] = 0;
+        sum[s] = 0;
+        dead[s] = 0;
+
+        b[s]  = (Real)batch.b[s];
+        c1[s] = (Real)batch.c1[s];
+        c2[s] = (Real)batch.c2[s];
+        c3[s] = (Real)batch.c3[s];
+        amp[s]  = (Real)batch.refAmplitude[s];
+        bool isRamp = batch.rampTime[s] > 0.0;
+        ramp[s] = isRamp ? (Real)batch.rampTime[s] : (Real)1;
+        stepShape[s] = isRamp ? (Real)0 : (Real)1;
+        loadTime[s] = (Real)batch.loadTime[s];
+        loadSize[s] = (Real)batch.loadSize[s];
+    }
+
+    int steps = (int)(simTime / dtIn);
+
+    for (int i = 0; i < steps; i++) {
+        Real t = (Real)(i * dtIn);
+
+        #pragma omp simd
+        for (int s = 0; s < n; s++) {
+            // min(1, t / rampTime), or 1 for a step, without a branch
+            Real rise = stepShape[s] + t / ramp[s];
+            Real shape = rise < (Real)1 ? rise : (Real)1;
+            Real error = amp[s] * shape - y[s];
+
+            // PID terms
+            Real integ = integral[s] + error * dt;
+            Real derivative = (error - prevError[s]) / dt;
+            Real u = Kp * error + Ki * integ + Kd * derivative;
+            Real load = loadSize[s];
+            Real uPlant = u + (t >= loadTime[s] ? load : (Real)0);
+
+            // plant simulation (x1 == y)
+            Real ny, nx2 = x2[s], nx3 = x3[s];
+            if (ORDER == 1) {
+                ny = y[s] + dt * (-c1[s] * y[s] + b[s] * uPlant);
+            } else if (ORDER == 2) {
+                Real y_ddot = b[s] * uPlant - c1[s] * x2[s] - c2[s] * y[s];
+                nx2 = x2[s] + dt * y_ddot;
+                ny  = y[s] + dt * nx2;
+            } else {
+                Real y_dddot = b[s] * uPlant - c1[s] * x3[s] - c2[s] * x2[s] - c3[s] * y[s];
+                nx3 = x3[s] + dt * y_dddot;
+                nx2 = x2[s] + dt * nx3;
+                ny  = y[s] + dt * nx2;
+            }
+
+            // !(a <= MAX) is also true for NaN
+            int bad = !(fabs(u) <= maxVal) | !(fabs(integ) <= maxVal) |
+                      !(fabs(ny) <= maxVal);
+            int d = dead[s] | bad;
+
+            // error is always finite (y is reset once a lane dies), so it
+            // is masked by a 0/1 factor: a select here becomes a branch
+            // around an FP op that may trap, and the loop is not vectorized
+            Acc alive = (Acc)(1 - d);
+            sum[s]      += alive * ((Acc)error * (Acc)error);
+            y[s]         = d ? (Real)0 : ny;
+            x2[s]        = d ? (Real)0 : nx2;
+            x3[s]        = d ? (Real)0 : nx3;
+            integral[s]  = d ? (Real)0 : integ;
+            prevError[s] = d ? (Real)0 : error;
+            dead[s]      = d;
+        }
+
+        // sums only grow, so the aggregate over all steps is a lower bound;
+        // it also reaches UNSTABLE_MSE once the result can only be a penalty
+        if ((i + 1) % EARLY_EXIT_INTERVAL == 0) {
+            double bound = aggregateMSE(batch, sum, dead, steps, aggregate);
+            if (bound >= cutoff || bound >= UNSTABLE_MSE) return bound;
+        }
+    }
+
+    if (steps <= 0) return 0.0;
+    return aggregateMSE(batch, sum, dead, steps, aggregate);
+}
+
+
+// kernel for the batch's plant order
+template <typename Real, typename Acc>
+static double simulateBatchOrder(const PIDParams& params, const ScenarioBatch& batch,
+                                 double dt, double simTime,
+                                 ScenarioAggregate aggregate, double cutoff)
+{
+    if (batch.order == 1)
+        return simulateBatchKernel<1, Real, Acc>(params, batch, dt, simTime, aggregate, cutoff);
+    if (batch.order == 2)
+        return simulateBatchKernel<2, Real, Acc>(params, batch, dt, simTime, aggregate, cutoff);
+    return simulateBatchKernel<3, Real, Acc>(params, batch, dt, simTime, aggregate, cutoff);
+}
+
+
+double simulatePIDBatch(const PIDParams& params, const ScenarioBatch& batch,
+                        double dt, double simTime,
+                        ScenarioAggregate aggregate, double cutoff,
+                        Precision precision)
+{
+    if (batch.count <= 0) return UNSTABLE_MSE;
+
+    if (precision == PRECISION_FLOAT)
+        return simulateBatchOrder<float, float>(params, batch, dt, simTime, aggregate, cutoff);
+    if (precision == PRECISION_MIXED)
+        return simulateBatchOrder<float, double>(params, batch, dt, simTime, aggregate, cutoff);
+    return simulateBatchOrder<double, double>(params, batch, dt, simTime, aggregate, cutoff);
+}
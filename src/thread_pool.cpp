@@ -0,0 +1,103 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+using namespace std;
+
+
+WorkStealingPool::WorkStealingPool(int threads)
+    : queues(max(1, threads)), stop(false), job(0), task(nullptr), remaining(0)
+{
+    for (int i = 1; i < size(); i++) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        lock_guard<std::mutex> guard(mutex);
+        stop = true;
+    }
+    wake.notify_all();
+    for (thread& w : workers) w.join();
+}
+
+
+// own deque first (LIFO), then steal from the others (FIFO)
+bool WorkStealingPool::take(int id, int& item)
+{
+    int n = size();
+    for (int k = 0; k < n; k++) {
+        Queue& q = queues[(id + k) % n];
+        lock_guard<std::mutex> guard(q.lock);
+        if (q.items.empty()) continue;
+
+        if (k == 0) {
+            item = q.items.back();
+            q.items.pop_back();
+        } else {
+            item = q.items.front();
+            q.items.pop_front();
+        }
+        return true;
+    }
+    return false;
+}
+
+
+// run one task if any is left; false when all deques are empty
+bool WorkStealingPool::runOne(int id)
+{
+    int item;
+    if (!take(id, item)) return false;
+
+    (*task)(item);
+
+    if (--remaining == 0) {
+        lock_guard<std::mutex> guard(mutex);
+        done.notify_all();
+    }
+    return true;
+}
+
+
+void WorkStealingPool::workerLoop(int id)
+{
+    long long seen = 0;
+    while (true) {
+        {
+            unique_lock<std::mutex> lk(mutex);
+            wake.wait(lk, [&]() { return stop || job != seen; });
+            if (stop) return;
+            seen = job;
+        }
+        while (runOne(id)) {}
+    }
+}
+
+
+void WorkStealingPool::parallelFor(int count, const function<void(int)>& f)
+{
+    if (count <= 0) return;
+
+    {
+        lock_guard<std::mutex> guard(mutex);
+        task = &f;
+        remaining = count;
+        for (int i = 0; i < count; i++) {
+            Queue& q = queues[i % size()];
+            lock_guard<std::mutex> qguard(q.lock);
+            q.items.push_back(i);
+        }
+        job++;
+    }
+    wake.notify_all();
+
+    // the caller works too
+    while (runOne(0)) {}
+
+    unique_lock<std::mutex> lk(mutex);
+    done.wait(lk, [&]() { return remaining == 0; });
+    task = nullptr;
+}
@@ -0,0 +1,129 @@
+#include "trace.h"
+#include <cstdio>
+#include <cstring>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+
+static const char TRACE_MAGIC[8] = {'B', 'C', 'O', 'T', 'R', 'A', 'C', 'E'};
+static const int TRACE_COLUMNS = 3;
+
+static_assert(sizeof(TraceFileHeader) == 64, "trace file header must be 64 bytes");
+
+
+int traceSamples(double dt, double simTime, int decimation)
+{
+    int steps = (int)(simTime / dt);
+    if (steps <= 0 || decimation <= 0) return 0;
+    return (steps + decimation - 1) / decimation;
+}
+
+
+static void fillHeader(TraceFileHeader& h, const TraceBuffer& trace, int capacity)
+{
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, TRACE_MAGIC, sizeof(h.magic));
+    h.version = 1;
+    h.columns = TRACE_COLUMNS;
+    h.samples = trace.count;
+    h.capacity = capacity;
+    h.sampleTime = trace.sampleTime;
+    h.Kp = trace.params.Kp;
+    h.Ki = trace.params.Ki;
+    h.Kd = trace.params.Kd;
+}
+
+
+void initTraceBuffer(TraceBuffer& trace, double* y, double* u, double* error,
+                     int capacity, int decimation)
+{
+    trace.capacity = capacity;
+    trace.decimation = (decimation < 1 ? 1 : decimation);
+    trace.count = 0;
+    trace.sampleTime = 0.0;
+    trace.params.Kp = trace.params.Ki = trace.params.Kd = 0.0;
+
+    trace.y = y;
+    trace.u = u;
+    trace.error = error;
+
+    trace.mapping = nullptr;
+    trace.mappedBytes = 0;
+    trace.fileBacked = false;
+}
+
+
+bool mapTraceBuffer(TraceBuffer& trace, int capacity, int decimation,
+                    const char* path)
+{
+    size_t column = (size_t)capacity * sizeof(double);
+    size_t bytes = TRACE_COLUMNS * column;
+    size_t offset = 0;      // columns start after the header in a file
+    void* block;
+
+    if (path == nullptr) {
+        if (bytes == 0) bytes = sizeof(double);
+        block = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    } else {
+        offset = sizeof(TraceFileHeader);
+        bytes += offset;
+
+        int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+        if (ftruncate(fd, (off_t)bytes) != 0) {
+            close(fd);
+            return false;
+        }
+        block = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);   // the mapping keeps the file open
+    }
+    if (block == MAP_FAILED) return false;
+
+    char* base = (char*)block + offset;
+    initTraceBuffer(trace, (double*)base, (double*)(base + column),
+                    (double*)(base + 2 * column), capacity, decimation);
+    trace.mapping = block;
+    trace.mappedBytes = bytes;
+    trace.fileBacked = (path != nullptr);
+    return true;
+}
+
+
+void unmapTraceBuffer(TraceBuffer& trace)
+{
+    if (trace.mapping == nullptr) return;
+
+    if (trace.fileBacked) {
+        fillHeader(*(TraceFileHeader*)trace.mapping, trace, trace.capacity);
+        msync(trace.mapping, trace.mappedBytes, MS_SYNC);
+    }
+    munmap(trace.mapping, trace.mappedBytes);
+
+    trace.mapping = nullptr;
+    trace.mappedBytes = 0;
+    trace.y = trace.u = trace.error = nullptr;
+    trace.capacity = 0;
+}
+
+
+bool writeTraceFile(const char* path, const TraceBuffer& trace)
+{
+    FILE* f = fopen(path, "wb");
+    if (f == nullptr) return false;
+
+    TraceFileHeader h;
+    fillHeader(h, trace, trace.count);
+
+    // columns are written straight from the trace storage
+    size_t n = (size_t)trace.count;
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1 &&
+              fwrite(trace.y, sizeof(double), n, f) == n &&
+              fwrite(trace.u, sizeof(double), n, f) == n &&
+              fwrite(trace.error, sizeof(double), n, f) == n;
+
+    return fclose(f) == 0 && ok;
+}
@@ -1,9 +1,21 @@
 #include "utils.h"
 #include <random>
+#ifdef _OPENMP
 #include <omp.h>
+#endif
 
 using namespace std;
 
+// omp thread id (0 when built without OpenMP)
+static int threadId()
+{
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
 // Thread-local RNG and state
 thread_local mt19937 rng;
 thread_local bool rng_ready = false;
@@ -18,7 +30,7 @@ static int GLOBAL_SEED = 12345;
 void initRandom(int seed)
 {
     GLOBAL_SEED = seed;
-    rng.seed(GLOBAL_SEED + omp_get_thread_num());
+    rng.seed(GLOBAL_SEED + threadId());
     rng_ready = true;
 }
 
@@ -27,7 +39,7 @@ void initRandom(int seed)
 inline void ensure_rng()
 {
     if (!rng_ready) {
-        rng.seed(GLOBAL_SEED + omp_get_thread_num());
+        rng.seed(GLOBAL_SEED + threadId());
         rng_ready = true;
     }
 }
@@ -48,6 +60,20 @@ int randomInt(int min, int max)
     return dist(rng);
 }
 
+// Random double in [min, max] from gen
+double randomDouble(mt19937& gen, double min, double max)
+{
+    uniform_real_distribution<double> dist(min, max);
+    return dist(gen);
+}
+
+// Random integer in [min, max] from gen
+int randomInt(mt19937& gen, int min, int max)
+{
+    uniform_int_distribution<int> dist(min, max);
+    return dist(gen);
+}
+
 // Clamp values
 double clamp(double x, double minVal, double maxVal)
 {